@@ -21,34 +21,13 @@
 #include <utility>
 #include <type_traits>
 #include <numeric>
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <ostream>
 
 
-#if __CUDA_ARCH__
-#define SIMBPOLIC_CUDA_AVAILABLE 1
-#elif __CUDA__
-#define SIMBPOLIC_CUDA_AVAILABLE 1
-#else
-#define SIMBPOLIC_CUDA_AVAILABLE 0
-#endif
-
-//For maximum interoperatability between CUDA and normal code.
-#if SIMBPOLIC_CUDA_AVAILABLE
-#define SIMBPOLIC_CUDA_HOS_DEV __host__ __device__
-#else
-#define SIMBPOLIC_CUDA_HOS_DEV
-#endif
-
-#if SIMBPOLIC_CUDA_AVAILABLE
-#define SIMBPOLIC_CUDA_ONLY_HOS __host__
-#else
-#define SIMBPOLIC_CUDA_ONLY_HOS
-#endif
-
-#if SIMBPOLIC_CUDA_AVAILABLE
-#define SIMBPOLIC_CUDA_ONLY_DEV __device__
-#else
-#define SIMBPOLIC_CUDA_ONLY_DEV
-#endif
+#include "simbpolic/platform.h"
 
 namespace Simbpolic
 {  
@@ -58,7 +37,9 @@ namespace Simbpolic
     
     \detail Supported aliases:
               - \c ResultType, the type of the numeric results.
-                Should be able to hold real results (so, floating point).
+                Should be able to hold real results (so, floating point),
+                though it may also be something like `dual<double>` (see `simbpolic/dual.h`)
+                to get derivatives alongside the values.
               - \c IntegerType, the type that holds integer quantities.
                 Must be signed!
               
@@ -536,7 +517,25 @@ public:
 #include "simbpolic/branch.h"
 #include "simbpolic/interval.h"
 #include "simbpolic/branching_helper.h"
+#include "simbpolic/expression_traits.h"
+#include "simbpolic/distribute.h"
+#include "simbpolic/separable.h"
 #include "simbpolic/integrate.h"
+#include "simbpolic/cuts.h"
+#include "simbpolic/evaluate.h"
+#include "simbpolic/quadrature.h"
+#include "simbpolic/batch.h"
+#include "simbpolic/projection.h"
+#include "simbpolic/moments.h"
+#include "simbpolic/piecewise.h"
+#include "simbpolic/convolution.h"
+#include "simbpolic/derivatives.h"
+#include "simbpolic/adjoint.h"
+#include "simbpolic/parameters.h"
+#include "simbpolic/partial.h"
+#include "simbpolic/uniform.h"
+#include "simbpolic/tabulate.h"
+#include "simbpolic/grid.h"
 
 namespace Simbpolic
 {
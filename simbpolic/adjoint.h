@@ -0,0 +1,302 @@
+#ifndef SIMBPOLIC_ADJOINT
+#define SIMBPOLIC_ADJOINT
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    template <class Func>
+    using first_operand_type = std::decay_t<decltype(std::declval<const Func&>().f1())>;
+
+    template <class Func>
+    using second_operand_type = std::decay_t<decltype(std::declval<const Func&>().f2())>;
+
+    template <class Func>
+    using third_operand_type = std::decay_t<decltype(std::declval<const Func&>().f3())>;
+
+    /*!
+      \brief The values of every node of \p Func at some point, laid out with the same shape as the expression,
+             so that they can be used in the backward sweep without recording anything at run-time.
+
+      \remark For branched functions, `piece` is the index of the piece that was evaluated,
+              or -1 (-2) if the point was exactly at the (upper) cut-off point,
+              where the average of both sides was taken.
+    */
+    template <class Func, class Enable = void>
+    struct adjoint_tape
+    {
+      Type value {};
+    };
+
+    template <class Func>
+    struct adjoint_tape<Func, std::enable_if_t<is_op_func<Func>>>
+    {
+      Type value {};
+      adjoint_tape<first_operand_type<Func>> first {};
+      adjoint_tape<second_operand_type<Func>> second {};
+    };
+
+    template <class Func>
+    struct adjoint_tape<Func, std::enable_if_t<branch_dimension<Func> != 0 && !is_interval_function<Func>>>
+    {
+      Type value {};
+      indexer piece = 0;
+      adjoint_tape<first_operand_type<Func>> first {};
+      adjoint_tape<second_operand_type<Func>> second {};
+    };
+
+    template <class Func>
+    struct adjoint_tape<Func, std::enable_if_t<is_interval_function<Func>>>
+    {
+      Type value {};
+      indexer piece = 0;
+      adjoint_tape<first_operand_type<Func>> first {};
+      adjoint_tape<second_operand_type<Func>> second {};
+      adjoint_tape<third_operand_type<Func>> third {};
+    };
+
+    template <class Store, class Cut>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Type cut_value(const Store& store, const Cut& cut)
+    {
+      if constexpr (is_stored<Cut>)
+        {
+          return Type(cut(store));
+        }
+      else
+        {
+          return Type(cut);
+        }
+    }
+
+    /*!
+      \brief The forward sweep: stores in \p tape the value of every node of \p f at \p point.
+    */
+    template <class Func, class Store, std::size_t M>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void adjoint_forward(const Func& f, const Store& store, const Type (&point)[M],
+                                                                        adjoint_tape<std::decay_t<Func>>& tape)
+    {
+      if constexpr (is_exact<Func>)
+        {
+          tape.value = Type(f);
+        }
+      else if constexpr (std::is_same_v<std::decay_t<Func>, Constant>)
+        {
+          tape.value = f.val;
+        }
+      else if constexpr (is_stored<std::decay_t<Func>>)
+        {
+          tape.value = Type(f(store));
+        }
+      else if constexpr (is_monomial<Func>)
+        {
+          tape.value = fastpow(point[monomial_dimension<Func> - 1], monomial_order<Func>);
+        }
+      else if constexpr (is_op_func<Func>)
+        {
+          adjoint_forward(f.f1(), store, point, tape.first);
+          adjoint_forward(f.f2(), store, point, tape.second);
+          switch (operation_of<Func>)
+            {
+              case operation_kind::add:
+                tape.value = tape.first.value + tape.second.value;
+                break;
+              case operation_kind::subtract:
+                tape.value = tape.first.value - tape.second.value;
+                break;
+              case operation_kind::multiply:
+                tape.value = tape.first.value * tape.second.value;
+                break;
+              default:
+                tape.value = tape.first.value / tape.second.value;
+                break;
+            }
+        }
+      else if constexpr (is_interval_function<Func>)
+        {
+          const Type x = point[branch_dimension<Func> - 1];
+          const Type lower = cut_value(store, f.lower_cut()), upper = cut_value(store, f.upper_cut());
+          if (x < lower)
+            {
+              tape.piece = 0;
+              adjoint_forward(f.f1(), store, point, tape.first);
+              tape.value = tape.first.value;
+            }
+          else if (x == lower)
+            {
+              tape.piece = -1;
+              adjoint_forward(f.f1(), store, point, tape.first);
+              adjoint_forward(f.f2(), store, point, tape.second);
+              tape.value = (tape.first.value + tape.second.value) / Type(2);
+            }
+          else if (x < upper)
+            {
+              tape.piece = 1;
+              adjoint_forward(f.f2(), store, point, tape.second);
+              tape.value = tape.second.value;
+            }
+          else if (x == upper)
+            {
+              tape.piece = -2;
+              adjoint_forward(f.f2(), store, point, tape.second);
+              adjoint_forward(f.f3(), store, point, tape.third);
+              tape.value = (tape.second.value + tape.third.value) / Type(2);
+            }
+          else
+            {
+              tape.piece = 2;
+              adjoint_forward(f.f3(), store, point, tape.third);
+              tape.value = tape.third.value;
+            }
+        }
+      else
+        {
+          static_assert(branch_dimension<Func> != 0, "Unsupported kind of expression!");
+          const Type x = point[branch_dimension<Func> - 1];
+          const Type cut = cut_value(store, f.cut());
+          if (x < cut)
+            {
+              tape.piece = 0;
+              adjoint_forward(f.f1(), store, point, tape.first);
+              tape.value = tape.first.value;
+            }
+          else if (x > cut)
+            {
+              tape.piece = 1;
+              adjoint_forward(f.f2(), store, point, tape.second);
+              tape.value = tape.second.value;
+            }
+          else
+            {
+              tape.piece = -1;
+              adjoint_forward(f.f1(), store, point, tape.first);
+              adjoint_forward(f.f2(), store, point, tape.second);
+              tape.value = (tape.first.value + tape.second.value) / Type(2);
+            }
+        }
+    }
+
+    /*!
+      \brief The backward sweep: adds `adjoint * df/dC_i` to `gradient[i]` for every `Stored<i>` in \p f.
+
+      \remark As with the derivatives along the dimensions, the cut-off points are considered fixed
+              (even if they are given by `Stored` constants), since the functions jump there.
+    */
+    template <class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void adjoint_backward(const Func& f, const adjoint_tape<std::decay_t<Func>>& tape,
+                                                                         const Type& adjoint, Type* gradient)
+    {
+      if constexpr (stored_count<Func> == 0)
+        {
+          return;
+        }
+      else if constexpr (is_stored<std::decay_t<Func>>)
+        {
+          constexpr indexer idx = stored_count<Func> - 1;
+          gradient[idx] = gradient[idx] + adjoint;
+        }
+      else if constexpr (is_op_func<Func>)
+        {
+          switch (operation_of<Func>)
+            {
+              case operation_kind::add:
+                adjoint_backward(f.f1(), tape.first, adjoint, gradient);
+                adjoint_backward(f.f2(), tape.second, adjoint, gradient);
+                break;
+              case operation_kind::subtract:
+                adjoint_backward(f.f1(), tape.first, adjoint, gradient);
+                adjoint_backward(f.f2(), tape.second, -adjoint, gradient);
+                break;
+              case operation_kind::multiply:
+                adjoint_backward(f.f1(), tape.first, adjoint * tape.second.value, gradient);
+                adjoint_backward(f.f2(), tape.second, adjoint * tape.first.value, gradient);
+                break;
+              default:
+                adjoint_backward(f.f1(), tape.first, adjoint / tape.second.value, gradient);
+                adjoint_backward(f.f2(), tape.second, -adjoint * tape.value / tape.second.value, gradient);
+                break;
+            }
+        }
+      else if constexpr (is_interval_function<Func>)
+        {
+          const Type half = adjoint / Type(2);
+          switch (tape.piece)
+            {
+              case 0:
+                adjoint_backward(f.f1(), tape.first, adjoint, gradient);
+                break;
+              case 1:
+                adjoint_backward(f.f2(), tape.second, adjoint, gradient);
+                break;
+              case 2:
+                adjoint_backward(f.f3(), tape.third, adjoint, gradient);
+                break;
+              case -1:
+                adjoint_backward(f.f1(), tape.first, half, gradient);
+                adjoint_backward(f.f2(), tape.second, half, gradient);
+                break;
+              default:
+                adjoint_backward(f.f2(), tape.second, half, gradient);
+                adjoint_backward(f.f3(), tape.third, half, gradient);
+                break;
+            }
+        }
+      else
+        {
+          switch (tape.piece)
+            {
+              case 0:
+                adjoint_backward(f.f1(), tape.first, adjoint, gradient);
+                break;
+              case 1:
+                adjoint_backward(f.f2(), tape.second, adjoint, gradient);
+                break;
+              default:
+                adjoint_backward(f.f1(), tape.first, adjoint / Type(2), gradient);
+                adjoint_backward(f.f2(), tape.second, adjoint / Type(2), gradient);
+                break;
+            }
+        }
+    }
+  }
+
+  /*!
+    \brief The value of a function together with its derivatives with respect to
+           each of the first \p N `Stored` constants.
+  */
+  template <indexer N>
+  struct stored_gradient
+  {
+    Type value {};
+    std::array<Type, N> gradient {};
+  };
+
+  /*!
+    \brief Evaluates \p f at the point given by \p args, with the constants taken from \p store,
+           also giving the derivatives of \p f with respect to every `Stored` constant it contains.
+
+    \remark This uses reverse-mode differentiation: one forward sweep records the value of every node
+            (in a structure with the same shape as the expression, so nothing is allocated),
+            and one backward sweep propagates the derivatives to the constants,
+            so the cost does not depend on how many constants there are.
+
+    \pre \p Store must derive from `Store` and there must be a value for every dimension of \p f.
+  */
+  template <class Func, class StoreT, class ... Args>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static stored_gradient<stored_count<Func>> adjoint(const Func& f, const StoreT& store,
+                                                                                            const Args& ... args)
+  {
+    static_assert(is_store<StoreT>, "The constants must be given through a store!");
+    static_assert(sizeof...(Args) >= std::size_t(Func::max_dimension), "There must be a value for every dimension of the function!");
+
+    const Type point[sizeof...(Args) + 1] = {Type(args)...};
+    internals::adjoint_tape<std::decay_t<Func>> tape {};
+    internals::adjoint_forward(f, store, point, tape);
+
+    stored_gradient<stored_count<Func>> ret {};
+    ret.value = tape.value;
+    internals::adjoint_backward(f, tape, Type(1), ret.gradient.data());
+    return ret;
+  }
+}
+
+#endif
@@ -0,0 +1,441 @@
+#ifndef SIMBPOLIC_ANY_FUNCTION
+#define SIMBPOLIC_ANY_FUNCTION
+
+#include <stdexcept>
+#include <cstddef>
+#include <new>
+
+#include "../simbpolic.h"
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    /*!
+      \brief The number of bytes `any_function` can hold without allocating.
+    */
+    inline static constexpr std::size_t any_function_buffer_size = 64;
+
+    /*!
+      \brief The interface through which `any_function` reaches the function it holds.
+             Every call works on a whole batch of points, so the indirect call is paid once per batch.
+    */
+    class any_function_interface
+    {
+      public:
+
+      virtual ~any_function_interface() = default;
+
+      virtual indexer max_dimension() const = 0;
+
+      virtual indexer stored_count() const = 0;
+
+      virtual void evaluate(const Type* const* coordinates, const std::size_t n, Type* results, const Type* parameters) const = 0;
+
+      virtual void derivative(const indexer dim, const Type* const* coordinates, const std::size_t n,
+                              Type* results, const Type* parameters) const = 0;
+
+      virtual void integrate(const indexer dim, const Type* starts, const Type* ends, const Type* const* coordinates,
+                             const std::size_t n, Type* results, const Type* parameters) const = 0;
+
+      /*!
+        \brief Copies the function into \p buffer, if it fits there, or into a new allocation otherwise.
+      */
+      virtual any_function_interface* copy_to(void* buffer) const = 0;
+
+      /*!
+        \brief Moves the function into \p buffer. Only called for functions that fit there.
+      */
+      virtual any_function_interface* move_to(void* buffer) = 0;
+    };
+
+    template <class Func>
+    class any_function_model final : public any_function_interface
+    {
+      public:
+
+      static constexpr indexer num_dims = (Func::max_dimension > 0 ? Func::max_dimension : 1);
+
+      static constexpr bool fits_buffer()
+      {
+        return sizeof(any_function_model) <= any_function_buffer_size && alignof(any_function_model) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Func>;
+      }
+
+      explicit any_function_model(const Func& f): m_f(f)
+      {
+      }
+
+      indexer max_dimension() const override
+      {
+        return Func::max_dimension;
+      }
+
+      indexer stored_count() const override
+      {
+        return Simbpolic::stored_count<Func>;
+      }
+
+      void evaluate(const Type* const* coordinates, const std::size_t n, Type* results, const Type* parameters) const override
+      {
+        Type point[num_dims] {};
+        for (std::size_t i = 0; i < n; ++i)
+          {
+            gather(point, coordinates, i);
+            results[i] = evaluate_with(m_f, point, parameters, 1);
+          }
+      }
+
+      void derivative(const indexer dim, const Type* const* coordinates, const std::size_t n,
+                      Type* results, const Type* parameters) const override
+      {
+        if (!dispatch(dim, [&](auto d) { derivative_along<decltype(d)::value>(coordinates, n, results, parameters); }))
+          {
+            for (std::size_t i = 0; i < n; ++i)
+              {
+                results[i] = Type(0);
+              }
+          }
+      }
+
+      void integrate(const indexer dim, const Type* starts, const Type* ends, const Type* const* coordinates,
+                     const std::size_t n, Type* results, const Type* parameters) const override
+      {
+        if (!dispatch(dim, [&](auto d) { integrate_along<decltype(d)::value>(starts, ends, coordinates, n, results, parameters); }))
+          {
+            //The function does not depend on dim at all.
+            evaluate(coordinates, n, results, parameters);
+            for (std::size_t i = 0; i < n; ++i)
+              {
+                results[i] = results[i] * (ends[i] - starts[i]);
+              }
+          }
+      }
+
+      any_function_interface* copy_to(void* buffer) const override
+      {
+        if constexpr (fits_buffer())
+          {
+            return new (buffer) any_function_model(*this);
+          }
+        else
+          {
+            return new any_function_model(*this);
+          }
+      }
+
+      any_function_interface* move_to(void* buffer) override
+      {
+        return new (buffer) any_function_model(std::move(*this));
+      }
+
+      private:
+
+      Func m_f;
+
+      static void gather(Type (&point)[num_dims], const Type* const* coordinates, const std::size_t i)
+      {
+        for (indexer d = 0; d < Func::max_dimension; ++d)
+          {
+            point[d] = coordinates[d][i];
+          }
+      }
+
+      template <indexer d = 1, class Visitor>
+      static bool dispatch(const indexer dim, Visitor&& visitor)
+      //Calls visitor with the compile-time counterpart of dim, if the function has that dimension.
+      {
+        if constexpr (d > Func::max_dimension)
+          {
+            return false;
+          }
+        else if (dim == d)
+          {
+            visitor(std::integral_constant<indexer, d>{});
+            return true;
+          }
+        else
+          {
+            return dispatch<d + 1>(dim, visitor);
+          }
+      }
+
+      template <indexer dim>
+      void derivative_along(const Type* const* coordinates, const std::size_t n, Type* results, const Type* parameters) const
+      {
+        using jet_type = gradient_jet<1>;
+        jet_type point[num_dims] {};
+        for (std::size_t i = 0; i < n; ++i)
+          {
+            for (indexer d = 0; d < Func::max_dimension; ++d)
+              {
+                point[d] = jet_type(coordinates[d][i]);
+              }
+            point[dim - 1] = jet_type::variable(coordinates[dim - 1][i], 0);
+            results[i] = evaluate_with(m_f, point, parameters, 1).gradient[0];
+          }
+      }
+
+      template <indexer dim>
+      void integrate_along(const Type* starts, const Type* ends, const Type* const* coordinates, const std::size_t n,
+                           Type* results, const Type* parameters) const
+      {
+        if constexpr (polynomial_degree<Func, dim> < 0)
+          {
+            throw std::domain_error("Only functions that are polynomials along the integration variable can be integrated!");
+          }
+        else
+          {
+            const auto prim = m_f.template primitive<dim>();
+            Type point[num_dims] {};
+            for (std::size_t i = 0; i < n; ++i)
+              {
+                gather(point, coordinates, i);
+                point[dim - 1] = ends[i];
+                results[i] = evaluate_with(prim, point, parameters, 1);
+                point[dim - 1] = starts[i];
+                results[i] = results[i] - evaluate_with(prim, point, parameters, 1);
+              }
+          }
+      }
+    };
+
+    template <class Func>
+    inline any_function_model<std::decay_t<Func>> make_any_function_model(const Func& f)
+    //Not static, as it initializes the inline variables of SIMBPOLIC_REGISTER_KERNEL in every translation unit.
+    {
+      return any_function_model<std::decay_t<Func>>(f);
+    }
+  }
+
+  /*!
+    \brief Holds any function (of any type), so that different functions can be kept in the same container
+           or chosen at run-time.
+
+    \details Functions that are small enough are kept inside the object itself (`internals::any_function_buffer_size`
+             bytes, including the pointer to the virtual table), larger ones are allocated.
+             Every operation is done for a whole batch of points, with the coordinates given as a structure of arrays
+             (the value of `x_d` at the point `i` being `coordinates[d - 1][i]`, for every dimension of the function)
+             and the value of `Stored<j>` being `parameters[j]`, so the cost of the virtual call is amortized
+             and the function itself is evaluated with all of its types known.
+
+    \remark The derivatives follow those of the expression templates (so the jumps at the cut-off points
+            are not taken into account), and integrating along a dimension the function is not a polynomial in
+            throws `std::domain_error`.
+
+    \remark An `any_function` can also refer to a model that is kept elsewhere (see `referring_to`),
+            in which case neither it nor its copies own (or allocate) anything.
+  */
+  class any_function
+  {
+    public:
+
+    any_function()
+    {
+    }
+
+    template <class Func, class = std::enable_if_t<is_symbolic<Func>>>
+    any_function(const Func& f)
+    {
+      using model_type = internals::any_function_model<std::decay_t<Func>>;
+      if constexpr (model_type::fits_buffer())
+        {
+          m_function = new (m_buffer) model_type(f);
+        }
+      else
+        {
+          m_function = new model_type(f);
+        }
+    }
+
+    any_function(const any_function& other)
+    {
+      if (other.m_borrowed)
+        {
+          m_function = other.m_function;
+          m_borrowed = true;
+        }
+      else if (other.m_function != nullptr)
+        {
+          m_function = other.m_function->copy_to(m_buffer);
+        }
+    }
+
+    /*!
+      \brief An `any_function` that refers to \p model, which must outlive it and all of its copies
+             (such as a model in static storage), without copying it nor allocating.
+    */
+    template <class Func>
+    static any_function referring_to(const internals::any_function_model<Func>& model)
+    {
+      any_function ret;
+      //A borrowed model is never moved nor destroyed, so only its const interface is ever used.
+      ret.m_function = const_cast<internals::any_function_model<Func>*>(&model);
+      ret.m_borrowed = true;
+      return ret;
+    }
+
+    any_function(any_function&& other) noexcept
+    {
+      take(other);
+    }
+
+    any_function& operator= (const any_function& other)
+    {
+      if (this != &other)
+        {
+          any_function copy(other);
+          reset();
+          take(copy);
+        }
+      return *this;
+    }
+
+    any_function& operator= (any_function&& other) noexcept
+    {
+      if (this != &other)
+        {
+          reset();
+          take(other);
+        }
+      return *this;
+    }
+
+    ~any_function()
+    {
+      reset();
+    }
+
+    /*!
+      \brief Whether this holds no function.
+    */
+    bool empty() const
+    {
+      return m_function == nullptr;
+    }
+
+    /*!
+      \brief Whether the function is kept inside the object itself.
+    */
+    bool is_local() const
+    {
+      return static_cast<const void*>(m_function) == static_cast<const void*>(m_buffer);
+    }
+
+    indexer max_dimension() const
+    {
+      return get().max_dimension();
+    }
+
+    indexer stored_count() const
+    {
+      return get().stored_count();
+    }
+
+    /*!
+      \brief Writes the value of the function at the point `i` to `results[i]`, for `i` from 0 to `n - 1`.
+    */
+    void evaluate(const Type* const* coordinates, const std::size_t n, Type* results, const Type* parameters = nullptr) const
+    {
+      get().evaluate(coordinates, n, results, checked(parameters));
+    }
+
+    /*!
+      \brief Writes the derivative of the function along \p dim at the point `i` to `results[i]`.
+    */
+    void derivative(const indexer dim, const Type* const* coordinates, const std::size_t n,
+                    Type* results, const Type* parameters = nullptr) const
+    {
+      check_dimension(dim);
+      get().derivative(dim, coordinates, n, results, checked(parameters));
+    }
+
+    /*!
+      \brief Writes the integral of the function along \p dim, from `starts[i]` to `ends[i]`,
+             with the other coordinates taken from the point `i`, to `results[i]`.
+    */
+    void integrate(const indexer dim, const Type* starts, const Type* ends, const Type* const* coordinates,
+                   const std::size_t n, Type* results, const Type* parameters = nullptr) const
+    {
+      check_dimension(dim);
+      get().integrate(dim, starts, ends, coordinates, n, results, checked(parameters));
+    }
+
+    private:
+
+    alignas(std::max_align_t) unsigned char m_buffer[internals::any_function_buffer_size];
+    internals::any_function_interface* m_function = nullptr;
+    bool m_borrowed = false;
+
+    const internals::any_function_interface& get() const
+    {
+      if (m_function == nullptr)
+        {
+          throw std::logic_error("The any_function does not hold a function!");
+        }
+      return *m_function;
+    }
+
+    const Type* checked(const Type* parameters) const
+    {
+      if (parameters == nullptr && get().stored_count() > 0)
+        {
+          throw std::invalid_argument("Stored constants need parameters to be evaluated!");
+        }
+      return parameters;
+    }
+
+    static void check_dimension(const indexer dim)
+    {
+      if (dim < 1)
+        {
+          throw std::invalid_argument("Dimensions start at 1!");
+        }
+    }
+
+    void take(any_function& other) noexcept
+    //Moves the function of other into this one (which must be empty), leaving other empty.
+    {
+      if (other.m_function == nullptr)
+        {
+          return;
+        }
+      if (other.m_borrowed)
+        {
+          m_function = other.m_function;
+          m_borrowed = true;
+          other.m_function = nullptr;
+          other.m_borrowed = false;
+        }
+      else if (other.is_local())
+        {
+          m_function = other.m_function->move_to(m_buffer);
+          other.reset();
+        }
+      else
+        {
+          m_function = other.m_function;
+          other.m_function = nullptr;
+        }
+    }
+
+    void reset() noexcept
+    {
+      if (m_borrowed)
+        {
+          m_borrowed = false;
+        }
+      else if (is_local())
+        {
+          m_function->~any_function_interface();
+        }
+      else
+        {
+          delete m_function;
+        }
+      m_function = nullptr;
+    }
+  };
+}
+
+#endif
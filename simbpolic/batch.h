@@ -0,0 +1,55 @@
+#ifndef SIMBPOLIC_BATCH
+#define SIMBPOLIC_BATCH
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    template <indexer dim, class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Type evaluate_along(const Func& f, const Type& x)
+    {
+      Type point[dim] {};
+      point[dim - 1] = x;
+      return evaluate_with(f, point);
+    }
+
+    /*!
+      \brief Writes `prim(ends[i]) - prim(starts[i])` to `results[i]`.
+
+      \remark Done in two separate passes so that each loop only involves one kind of evaluation.
+    */
+    template <indexer dim, class Prim>
+    SIMBPOLIC_CUDA_HOS_DEV inline static void primitive_differences(const Prim& prim, const Type* starts, const Type* ends,
+                                                                    Type* results, const std::size_t n)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        {
+          results[i] = evaluate_along<dim>(prim, ends[i]);
+        }
+      for (std::size_t i = 0; i < n; ++i)
+        {
+          results[i] = results[i] - evaluate_along<dim>(prim, starts[i]);
+        }
+    }
+  }
+
+  /*!
+    \brief Writes the integral of \p f along \p dim from `starts[i]` to `ends[i]` to `results[i]`,
+           for `i` from 0 to `n - 1`.
+
+    \remark The primitive is only computed once, and it is continuous across the cut-off points
+            of branched functions, so limits on different pieces are handled correctly.
+
+    \pre \p f may only depend on \p dim.
+  */
+  template <class Func, indexer dim>
+  SIMBPOLIC_CUDA_HOS_DEV inline static void integrate_batch(const Func& f, const Var<dim> &var, const Type* starts, const Type* ends,
+                                                            Type* results, const std::size_t n)
+  {
+    static_assert(internals::integrates_all_dimensions<Func, 1, Var<dim>>(), "The function may only depend on the integration variable!");
+    const auto prim = f.template primitive<dim>();
+    internals::primitive_differences<dim>(prim, starts, ends, results, n);
+  }
+}
+
+#endif
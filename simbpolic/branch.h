@@ -11,17 +11,17 @@ namespace Simbpolic
     
     using func_holder<A, B, Cut>::func_holder;
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f1() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f1() const
     {
       return func_holder<A, B, Cut>::template get<0>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f2() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f2() const
     {
       return func_holder<A, B, Cut>::template get<1>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto cut() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) cut() const
     {
       return func_holder<A, B, Cut>::template get<2>();
     }
@@ -80,6 +80,13 @@ namespace Simbpolic
         {
           return A{} * Monomial<1, dimension>{};
         }
+      else if constexpr (has_dimension<dimension>() && dimension != dim)
+        {
+          const auto prim_1 = f1().template primitive<dimension>();
+          const auto prim_2 = f2().template primitive<dimension>();
+          return branch_function<decltype(prim_1), decltype(prim_2), dim, Cut>{prim_1, prim_2, cut()};
+          //The pieces do not meet along dimension, so no integration constants are needed.
+        }
       else if constexpr (has_dimension<dimension>())
         {
           const auto prim_1 = f1().template primitive<dimension>();
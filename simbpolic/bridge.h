@@ -0,0 +1,96 @@
+#ifndef SIMBPOLIC_BRIDGE
+#define SIMBPOLIC_BRIDGE
+
+#include <cstddef>
+
+#include "../simbpolic.h"
+#include "dynamic.h"
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    template <class Func>
+    inline static const dynamic_node* to_dynamic_impl(const Func& f, dynamic_arena& arena)
+    //Equal subexpressions are merged by the arena.
+    {
+      if constexpr (is_exact<Func>)
+        {
+          const exact_fraction value = exact_value_of(f);
+          return arena.rational(value.num, value.den);
+        }
+      else if constexpr (std::is_same_v<std::decay_t<Func>, Constant>)
+        {
+          return arena.constant(f.val);
+        }
+      else if constexpr (is_stored<std::decay_t<Func>>)
+        {
+          return arena.stored(stored_count<Func> - 1);
+        }
+      else if constexpr (is_monomial<Func>)
+        {
+          return arena.monomial(monomial_order<Func>, monomial_dimension<Func>);
+        }
+      else if constexpr (is_op_func<Func>)
+        {
+          const dynamic_node* first = to_dynamic_impl(f.f1(), arena);
+          const dynamic_node* second = to_dynamic_impl(f.f2(), arena);
+          switch (operation_of<Func>)
+            {
+              case operation_kind::add:
+                return arena.add(first, second);
+              case operation_kind::subtract:
+                return arena.subtract(first, second);
+              case operation_kind::multiply:
+                return arena.multiply(first, second);
+              default:
+                return arena.divide(first, second);
+            }
+        }
+      else if constexpr (is_interval_function<Func>)
+        {
+          return arena.piecewise(branch_dimension<Func>,
+                                 {to_dynamic_impl(f.lower_cut(), arena), to_dynamic_impl(f.upper_cut(), arena)},
+                                 {to_dynamic_impl(f.f1(), arena), to_dynamic_impl(f.f2(), arena), to_dynamic_impl(f.f3(), arena)});
+        }
+      else
+        {
+          static_assert(branch_dimension<Func> != 0, "Unsupported kind of expression!");
+          return arena.piecewise(branch_dimension<Func>, {to_dynamic_impl(f.cut(), arena)},
+                                 {to_dynamic_impl(f.f1(), arena), to_dynamic_impl(f.f2(), arena)});
+        }
+    }
+  }
+
+  /*!
+    \brief Builds in \p arena the runtime expression (see `dynamic_arena`) equivalent to \p f,
+           so that the expensive symbolic operations can be done at run-time
+           instead of by instantiating ever larger types.
+
+    \pre The cut-off points of the interval functions in \p f must be increasing.
+  */
+  template <class Func>
+  inline static const dynamic_node* to_dynamic(const Func& f, dynamic_arena& arena)
+  {
+    static_assert(is_symbolic<Func>, "Should be called with symbolic functions!");
+    return internals::to_dynamic_impl(f, arena);
+  }
+
+  /*!
+    \brief Checks that \p f and the runtime expression \p g give exactly the same value at \p point
+           (with `point[d - 1]` being the value of `x_d`), with the value of `Stored<i>` taken from `parameters[i]`.
+
+    \remark Since `to_dynamic` keeps the structure of the expression (and both paths take the same pieces
+            and the same averages at the cut-off points), this should hold bit for bit for its results.
+  */
+  template <class Func, std::size_t M>
+  inline static bool evaluates_identically(const Func& f, const dynamic_node* g, const Type (&point)[M], const Type* parameters = nullptr)
+  {
+    static_assert(Func::max_dimension <= indexer(M), "The point must have a value for every dimension of the function!");
+    const Type static_value = internals::evaluate_with(f, point, parameters, 1);
+    const Type dynamic_value = evaluate_dynamic(g, point, parameters);
+    return static_value == dynamic_value;
+  }
+}
+
+#endif
@@ -0,0 +1,458 @@
+#ifndef SIMBPOLIC_BYTECODE
+#define SIMBPOLIC_BYTECODE
+
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstddef>
+
+#include "../simbpolic.h"
+#include "dynamic.h"
+
+namespace Simbpolic
+{
+  enum class dynamic_opcode
+  {
+    constant, parameter, power, horner, add, subtract, multiply, divide, piecewise
+  };
+
+  /*!
+    \brief An instruction of a `dynamic_program`, writing to the register `target`.
+
+    \details Depending on the opcode:
+               - `constant`: `constants[start]`;
+               - `parameter`: `parameters[first]`;
+               - `power`: `x_dim ^ first`;
+               - `horner`: the polynomial in `x_dim` of degree `count`
+                 with coefficients `constants[start]` (constant term) to `constants[start + count]`;
+               - `add`, `subtract`, `multiply` and `divide`: the registers `first` and `second`;
+               - `piecewise`: along `dim`, with `count` cut-off points; `operands[start]` to `operands[start + count]`
+                 are the registers holding the pieces, followed by the cut-off points, given as indices
+                 into the constants (if non-negative) or as `-1 - i` for `parameters[i]`.
+  */
+  struct dynamic_instruction
+  {
+    dynamic_opcode op = dynamic_opcode::constant;
+    indexer target = 0, first = 0, second = 0, dim = 0, count = 0;
+    std::size_t start = 0;
+  };
+
+  /*!
+    \brief A runtime expression compiled to a linear sequence of instructions for a register machine
+           (see `compile_program` and `evaluate_program`).
+  */
+  struct dynamic_program
+  {
+    std::vector<dynamic_instruction> code;
+    std::vector<Type> constants;
+    std::vector<indexer> operands;
+    indexer num_registers = 0, result = 0, max_dimension = 0, stored_count = 0;
+  };
+
+  namespace internals
+  {
+    /*!
+      \brief The number of points each instruction is run over at a time by `evaluate_program`.
+    */
+    inline static constexpr std::size_t program_block_size = 256;
+
+    /*!
+      \brief Compiles a runtime expression into a `dynamic_program`, giving each node its own register
+             only while its value is still needed.
+    */
+    class program_compiler
+    {
+      public:
+
+      dynamic_program program;
+
+      explicit program_compiler(const dynamic_node* f)
+      {
+        count_uses(f);
+        program.result = emit(f);
+        program.max_dimension = f->max_dimension();
+        program.stored_count = f->stored_count;
+      }
+
+      private:
+
+      std::unordered_map<const dynamic_node*, indexer> m_uses, m_registers, m_degrees;
+      std::unordered_map<const dynamic_node*, bool> m_fused;
+      std::unordered_map<const dynamic_node*, std::vector<Type>> m_coefficients;
+      std::vector<indexer> m_free;
+
+      static indexer single_dimension(const dynamic_node* f)
+      //The dimension f depends on, if it is only one, or 0.
+      {
+        if (f->dimensions == 0 || (f->dimensions & (f->dimensions - 1)) != 0)
+          {
+            return 0;
+          }
+        return f->max_dimension();
+      }
+
+      bool is_fused_polynomial(const dynamic_node* f)
+      //Whether f can be evaluated by a single Horner instruction.
+      {
+        if (f->kind != dynamic_kind::add && f->kind != dynamic_kind::subtract &&
+            f->kind != dynamic_kind::multiply && f->kind != dynamic_kind::divide)
+          {
+            return false;
+          }
+        const auto found = m_fused.find(f);
+        if (found != m_fused.end())
+          {
+            return found->second;
+          }
+        const indexer dim = single_dimension(f);
+        //A node that depends on a single dimension is only ever asked about that one,
+        //so the degrees of all the candidates can share m_degrees.
+        const bool ret = dim != 0 && f->cut_dimensions == 0 && f->stored_count == 0 && dynamic_degree(f, dim, m_degrees) >= 0;
+        m_fused[f] = ret;
+        return ret;
+      }
+
+      const std::vector<Type>& coefficients(const dynamic_node* f, const indexer dim)
+      //The coefficients (lowest power first, up to its degree) of f, a polynomial in x_dim with numeric coefficients.
+      //They are kept for each node, since the nodes of a polynomial are often shared.
+      {
+        const auto found = m_coefficients.find(f);
+        if (found != m_coefficients.end())
+          {
+            return found->second;
+          }
+        std::vector<Type> ret(std::size_t(dynamic_degree(f, dim, m_degrees)) + 1, Type(0));
+        switch (f->kind)
+          {
+            case dynamic_kind::rational:
+            case dynamic_kind::constant:
+              ret[0] = f->number();
+              break;
+            case dynamic_kind::monomial:
+              ret[std::size_t(f->index)] = Type(1);
+              break;
+            case dynamic_kind::add:
+            case dynamic_kind::subtract:
+              {
+                const std::vector<Type>& a = coefficients(f->operands[0], dim);
+                const std::vector<Type>& b = coefficients(f->operands[1], dim);
+                for (std::size_t i = 0; i < a.size(); ++i)
+                  {
+                    ret[i] = a[i];
+                  }
+                for (std::size_t i = 0; i < b.size(); ++i)
+                  {
+                    ret[i] = (f->kind == dynamic_kind::add ? ret[i] + b[i] : ret[i] - b[i]);
+                  }
+                break;
+              }
+            case dynamic_kind::multiply:
+              {
+                const std::vector<Type>& a = coefficients(f->operands[0], dim);
+                const std::vector<Type>& b = coefficients(f->operands[1], dim);
+                for (std::size_t i = 0; i < a.size(); ++i)
+                  {
+                    for (std::size_t j = 0; j < b.size(); ++j)
+                      {
+                        ret[i + j] = ret[i + j] + a[i] * b[j];
+                      }
+                  }
+                break;
+              }
+            default:
+              {
+                const std::vector<Type>& a = coefficients(f->operands[0], dim);
+                const Type b = f->operands[1]->number();
+                for (std::size_t i = 0; i < a.size(); ++i)
+                  {
+                    ret[i] = a[i] / b;
+                  }
+                break;
+              }
+          }
+        //The references to the other entries stay valid, as the map does not move its elements.
+        return m_coefficients.emplace(f, std::move(ret)).first->second;
+      }
+
+      indexer num_children(const dynamic_node* f)
+      //The nodes whose values the instruction for f reads (the cut-off points are read directly).
+      {
+        if (is_fused_polynomial(f))
+          {
+            return 0;
+          }
+        return (f->kind == dynamic_kind::piecewise ? f->num_cuts + 1 : f->num_operands());
+      }
+
+      void count_uses(const dynamic_node* f)
+      {
+        if (m_uses[f]++ > 0)
+          {
+            return;
+          }
+        for (indexer i = 0; i < num_children(f); ++i)
+          {
+            count_uses(f->operands[i]);
+          }
+      }
+
+      indexer allocate()
+      {
+        if (m_free.empty())
+          {
+            return program.num_registers++;
+          }
+        const indexer ret = m_free.back();
+        m_free.pop_back();
+        return ret;
+      }
+
+      void release(const dynamic_node* f)
+      {
+        if (--m_uses[f] == 0)
+          {
+            m_free.push_back(m_registers[f]);
+          }
+      }
+
+      indexer add_constant(const Type& value)
+      {
+        program.constants.push_back(value);
+        return indexer(program.constants.size() - 1);
+      }
+
+      indexer emit(const dynamic_node* f)
+      {
+        const auto found = m_registers.find(f);
+        if (found != m_registers.end())
+          {
+            return found->second;
+          }
+
+        dynamic_instruction instruction;
+        std::vector<indexer> children(std::size_t(num_children(f)));
+        for (std::size_t i = 0; i < children.size(); ++i)
+          {
+            children[i] = emit(f->operands[i]);
+          }
+
+        if (is_fused_polynomial(f))
+          {
+            const indexer dim = single_dimension(f);
+            const std::vector<Type>& polynomial = coefficients(f, dim);
+            instruction.op = dynamic_opcode::horner;
+            instruction.dim = dim;
+            instruction.count = indexer(polynomial.size()) - 1;
+            instruction.start = program.constants.size();
+            program.constants.insert(program.constants.end(), polynomial.begin(), polynomial.end());
+          }
+        else
+          {
+            switch (f->kind)
+              {
+                case dynamic_kind::rational:
+                case dynamic_kind::constant:
+                  instruction.op = dynamic_opcode::constant;
+                  instruction.start = std::size_t(add_constant(f->number()));
+                  break;
+                case dynamic_kind::stored:
+                  instruction.op = dynamic_opcode::parameter;
+                  instruction.first = f->index;
+                  break;
+                case dynamic_kind::monomial:
+                  instruction.op = dynamic_opcode::power;
+                  instruction.dim = f->dim;
+                  instruction.first = f->index;
+                  break;
+                case dynamic_kind::add:
+                case dynamic_kind::subtract:
+                case dynamic_kind::multiply:
+                case dynamic_kind::divide:
+                  instruction.op = (f->kind == dynamic_kind::add ? dynamic_opcode::add :
+                                    f->kind == dynamic_kind::subtract ? dynamic_opcode::subtract :
+                                    f->kind == dynamic_kind::multiply ? dynamic_opcode::multiply : dynamic_opcode::divide);
+                  instruction.first = children[0];
+                  instruction.second = children[1];
+                  break;
+                default:
+                  instruction.op = dynamic_opcode::piecewise;
+                  instruction.dim = f->dim;
+                  instruction.count = f->num_cuts;
+                  instruction.start = program.operands.size();
+                  program.operands.insert(program.operands.end(), children.begin(), children.end());
+                  for (indexer i = 0; i < f->num_cuts; ++i)
+                    {
+                      const dynamic_node* cut = f->cut(i);
+                      program.operands.push_back(cut->kind == dynamic_kind::stored ? -1 - cut->index : add_constant(cut->number()));
+                    }
+                  break;
+              }
+          }
+
+        for (std::size_t i = 0; i < children.size(); ++i)
+          {
+            release(f->operands[i]);
+          }
+        //Released before allocating, so the target may reuse the register of an operand
+        //(each instruction reads an operand at a point before writing the target there).
+        instruction.target = allocate();
+        m_registers[f] = instruction.target;
+        program.code.push_back(instruction);
+        return instruction.target;
+      }
+    };
+  }
+
+  /*!
+    \brief Compiles \p f to a linear program for a register machine, where each register holds
+           the values of a node for a block of points.
+
+    \details Equal subexpressions are only computed once (as they are a single node),
+             subexpressions that are polynomials in a single dimension (with numeric coefficients)
+             become a single Horner instruction, and each piecewise function becomes a search
+             for the piece that contains each point.
+  */
+  inline static dynamic_program compile_program(const dynamic_node* f)
+  {
+    return internals::program_compiler(f).program;
+  }
+
+  /*!
+    \brief Evaluates \p program at \p count points, writing the results to \p results.
+
+    \details The coordinates are given as a structure of arrays: the value of `x_d` at the point `i`
+             is `coordinates[d - 1][i]`. The value of `Stored<j>` is `parameters[j]`.
+             Each instruction is run over `internals::program_block_size` points at a time,
+             so that the cost of dispatching it is amortized and the loops can be vectorized.
+
+    \remark The semantics are those of `evaluate_dynamic` (with the average of both sides at the cut-off points),
+            except that the pieces are found by bisection, so stored cut-off points must also be increasing.
+  */
+  inline static void evaluate_program(const dynamic_program& program, const Type* const* coordinates, const std::size_t count,
+                                      Type* results, const Type* parameters = nullptr)
+  {
+    constexpr std::size_t B = internals::program_block_size;
+    if (program.stored_count > 0 && parameters == nullptr)
+      {
+        throw std::invalid_argument("Stored constants need parameters to be evaluated!");
+      }
+    std::vector<Type> registers(std::size_t(program.num_registers) * B);
+    std::vector<Type> cuts;
+    for (std::size_t begin = 0; begin < count; begin += B)
+      {
+        const std::size_t n = (count - begin < B ? count - begin : B);
+        for (const dynamic_instruction& ins : program.code)
+          {
+            Type* target = registers.data() + std::size_t(ins.target) * B;
+            const Type* first = registers.data() + std::size_t(ins.first) * B;
+            const Type* second = registers.data() + std::size_t(ins.second) * B;
+            const Type* x = (ins.dim > 0 ? coordinates[ins.dim - 1] + begin : nullptr);
+            switch (ins.op)
+              {
+                case dynamic_opcode::constant:
+                  for (std::size_t i = 0; i < n; ++i)
+                    {
+                      target[i] = program.constants[ins.start];
+                    }
+                  break;
+                case dynamic_opcode::parameter:
+                  for (std::size_t i = 0; i < n; ++i)
+                    {
+                      target[i] = parameters[ins.first];
+                    }
+                  break;
+                case dynamic_opcode::power:
+                  for (std::size_t i = 0; i < n; ++i)
+                    {
+                      target[i] = fastpow(x[i], ins.first);
+                    }
+                  break;
+                case dynamic_opcode::horner:
+                  {
+                    const Type* c = program.constants.data() + ins.start;
+                    for (std::size_t i = 0; i < n; ++i)
+                      {
+                        target[i] = c[ins.count];
+                      }
+                    for (indexer k = ins.count - 1; k >= 0; --k)
+                      {
+                        for (std::size_t i = 0; i < n; ++i)
+                          {
+                            target[i] = target[i] * x[i] + c[k];
+                          }
+                      }
+                    break;
+                  }
+                case dynamic_opcode::add:
+                  for (std::size_t i = 0; i < n; ++i)
+                    {
+                      target[i] = first[i] + second[i];
+                    }
+                  break;
+                case dynamic_opcode::subtract:
+                  for (std::size_t i = 0; i < n; ++i)
+                    {
+                      target[i] = first[i] - second[i];
+                    }
+                  break;
+                case dynamic_opcode::multiply:
+                  for (std::size_t i = 0; i < n; ++i)
+                    {
+                      target[i] = first[i] * second[i];
+                    }
+                  break;
+                case dynamic_opcode::divide:
+                  for (std::size_t i = 0; i < n; ++i)
+                    {
+                      target[i] = first[i] / second[i];
+                    }
+                  break;
+                default:
+                  {
+                    const indexer* pieces = program.operands.data() + ins.start;
+                    const indexer* cut_refs = pieces + ins.count + 1;
+                    cuts.resize(std::size_t(ins.count));
+                    for (indexer k = 0; k < ins.count; ++k)
+                      {
+                        cuts[k] = (cut_refs[k] >= 0 ? program.constants[cut_refs[k]] : parameters[-1 - cut_refs[k]]);
+                      }
+                    for (std::size_t i = 0; i < n; ++i)
+                      {
+                        indexer low = 0, high = ins.count;
+                        //The first cut-off point that is not below x.
+                        while (low < high)
+                          {
+                            const indexer middle = (low + high) / 2;
+                            if (cuts[middle] < x[i])
+                              {
+                                low = middle + 1;
+                              }
+                            else
+                              {
+                                high = middle;
+                              }
+                          }
+                        const Type value = registers[std::size_t(pieces[low]) * B + i];
+                        if (low < ins.count && cuts[low] == x[i])
+                          {
+                            target[i] = (value + registers[std::size_t(pieces[low + 1]) * B + i]) / Type(2);
+                          }
+                        else
+                          {
+                            target[i] = value;
+                          }
+                      }
+                    break;
+                  }
+              }
+          }
+        const Type* result = registers.data() + std::size_t(program.result) * B;
+        for (std::size_t i = 0; i < n; ++i)
+          {
+            results[begin + i] = result[i];
+          }
+      }
+  }
+}
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef SIMBPOLIC_CODEGEN
+#define SIMBPOLIC_CODEGEN
+
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <stdexcept>
+#include <cstddef>
+
+#include "../simbpolic.h"
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    template <class T>
+    inline static constexpr const char* source_type_name = nullptr;
+
+    template <>
+    inline constexpr const char* source_type_name<float> = "float";
+
+    template <>
+    inline constexpr const char* source_type_name<double> = "double";
+
+    template <>
+    inline constexpr const char* source_type_name<long double> = "long double";
+
+    /*!
+      \brief Whether \p Func is an operation that can be written as a single polynomial in one dimension
+             (with numeric coefficients), and thus be emitted in Horner form by `generate_source`.
+    */
+    template <class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static bool is_source_polynomial()
+    {
+      constexpr indexer dim = Func::max_dimension;
+      if constexpr (!is_op_func<Func> || dim <= 0)
+        {
+          return false;
+        }
+      else
+        {
+          return integrates_all_dimensions<Func, 1, Var<dim>>() && stored_count<Func> == 0 &&
+                 cut_count<Func, dim> == 0 && polynomial_degree<Func, dim> >= 0;
+        }
+    }
+
+    /*!
+      \brief Writes the C++ source of the expressions given to `expression`,
+             collecting in `definitions` the lambdas that hold the pieces of the branched functions.
+    */
+    class source_writer
+    {
+      public:
+
+      std::string definitions;
+
+      static std::string literal(const Type& value)
+      //Hexadecimal floating point literals, so that the values are kept exactly.
+      {
+        if (!std::isfinite(value))
+          {
+            throw std::domain_error("Only finite constants can be written as literals!");
+          }
+        std::ostringstream s;
+        s << std::hexfloat << value;
+        if constexpr (std::is_same_v<Type, float>)
+          {
+            s << "f";
+          }
+        else if constexpr (std::is_same_v<Type, long double>)
+          {
+            s << "L";
+          }
+        return (value < Type(0) ? "(" + s.str() + ")" : s.str());
+      }
+
+      static std::string coordinate(const indexer dim)
+      {
+        return "x[" + std::to_string(dim - 1) + "]";
+      }
+
+      static std::string power(const indexer dim, const indexer order)
+      //Repeated multiplications, with the reciprocal for negative orders.
+      {
+        const indexer count = (order < 0 ? -order : order);
+        if (count == 0)
+          {
+            return literal(Type(1));
+          }
+        std::string ret = coordinate(dim);
+        for (indexer i = 1; i < count; ++i)
+          {
+            ret += " * " + coordinate(dim);
+          }
+        return (order < 0 ? "(" + literal(Type(1)) + " / (" + ret + "))" : "(" + ret + ")");
+      }
+
+      template <class Cut>
+      static std::string cut_value(const Cut& cut)
+      {
+        if constexpr (is_stored<std::decay_t<Cut>>)
+          {
+            return "parameters[" + std::to_string(stored_count<Cut> - 1) + "]";
+          }
+        else
+          {
+            return literal(Type(cut));
+          }
+      }
+
+      template <class Func>
+      std::string expression(const Func& f)
+      {
+        if constexpr (is_exact<Func>)
+          {
+            return literal(Type(f));
+          }
+        else if constexpr (std::is_same_v<std::decay_t<Func>, Constant>)
+          {
+            return literal(f.val);
+          }
+        else if constexpr (is_stored<std::decay_t<Func>>)
+          {
+            return cut_value(f);
+          }
+        else if constexpr (is_monomial<Func>)
+          {
+            return power(monomial_dimension<Func>, monomial_order<Func>);
+          }
+        else if constexpr (is_source_polynomial<Func>())
+          {
+            return horner(f);
+          }
+        else if constexpr (is_op_func<Func>)
+          {
+            const std::string first = expression(f.f1()), second = expression(f.f2());
+            switch (operation_of<Func>)
+              {
+                case operation_kind::add:
+                  return "(" + first + " + " + second + ")";
+                case operation_kind::subtract:
+                  return "(" + first + " - " + second + ")";
+                case operation_kind::multiply:
+                  return "(" + first + " * " + second + ")";
+                default:
+                  return "(" + first + " / " + second + ")";
+              }
+          }
+        else if constexpr (is_interval_function<Func>)
+          {
+            const std::string x = coordinate(branch_dimension<Func>);
+            const std::string lower = cut_value(f.lower_cut()), upper = cut_value(f.upper_cut());
+            const std::string p1 = piece(f.f1()), p2 = piece(f.f2()), p3 = piece(f.f3());
+            return "(" + x + " < " + lower + " ? " + p1 + " : " + x + " == " + lower + " ? (" + p1 + " + " + p2 + ") / " + literal(Type(2)) +
+                   " : " + x + " < " + upper + " ? " + p2 + " : " + x + " == " + upper + " ? (" + p2 + " + " + p3 + ") / " + literal(Type(2)) +
+                   " : " + p3 + ")";
+          }
+        else
+          {
+            static_assert(branch_dimension<Func> != 0, "Unsupported kind of expression!");
+            const std::string x = coordinate(branch_dimension<Func>);
+            const std::string cut = cut_value(f.cut());
+            const std::string p1 = piece(f.f1()), p2 = piece(f.f2());
+            return "(" + x + " < " + cut + " ? " + p1 + " : " + x + " > " + cut + " ? " + p2 +
+                   " : (" + p1 + " + " + p2 + ") / " + literal(Type(2)) + ")";
+          }
+      }
+
+      private:
+
+      std::size_t m_pieces = 0;
+
+      template <class Func>
+      std::string piece(const Func& f)
+      //Each piece is written once, as a lambda, so that taking the average at a cut-off point
+      //does not duplicate the source of (possibly nested) branched functions.
+      {
+        const std::string body = expression(f);
+        const std::string name = "piece_" + std::to_string(m_pieces++);
+        definitions += std::string("  const auto ") + name + " = [&]() -> " + source_type_name<Type> + " { return " + body + "; };\n";
+        return name + "()";
+      }
+
+      template <class Func>
+      std::string horner(const Func& f)
+      {
+        constexpr indexer dim = Func::max_dimension;
+        using poly_type = dense_polynomial<1, polynomial_degree<Func, dim>>;
+        poly_type point[dim] {};
+        point[dim - 1] = poly_type::variable(0);
+        const poly_type p = evaluate_with(f, point);
+        const std::string x = coordinate(dim);
+        //The zero coefficients are skipped: the lowest powers are factored out as x^low
+        //and the others only leave the multiplication by x (as does a leading coefficient of one).
+        std::size_t low = 0, high = poly_type::size;
+        while (high > 0 && p.coefficients[high - 1] == Type(0))
+          {
+            --high;
+          }
+        if (high == 0)
+          {
+            return literal(Type(0));
+          }
+        while (p.coefficients[low] == Type(0))
+          {
+            ++low;
+          }
+        const std::string one = literal(Type(1));
+        std::string ret = literal(p.coefficients[high - 1]);
+        for (std::size_t i = high - 1; i > low; --i)
+          {
+            const std::string product = (ret == one ? x : x + " * " + ret);
+            if (p.coefficients[i - 1] == Type(0))
+              {
+                ret = "(" + product + ")";
+              }
+            else
+              {
+                ret = "(" + literal(p.coefficients[i - 1]) + " + " + product + ")";
+              }
+          }
+        return (low == 0 ? ret : "(" + power(dim, indexer(low)) + " * " + ret + ")");
+      }
+    };
+  }
+
+  /*!
+    \brief Gives the source code of a standalone C++ function, named \p name, that evaluates \p f.
+
+    \details The function has the signature `T name(const T* x, const T* parameters)`, where `T` is `Type`,
+             `x[d - 1]` is the value of the dimension `d` and `parameters[i]` the value of `Stored<i>`.
+             It only uses the built-in arithmetic: the constants are inlined (as hexadecimal literals, to be exact),
+             the subexpressions that are polynomials in a single dimension are expanded and written in Horner form,
+             and each branched function becomes a dispatch on its cut-off points (with the average of both sides
+             at the cut-off points, as usual), with its pieces written once as local lambdas.
+             Compiling the result in a translation unit of its own avoids instantiating the expression templates
+             in every translation unit that uses the function.
+
+    \remark The Horner form changes the order of the operations, so the results may differ from the evaluation
+            of \p f by rounding.
+
+    \throw std::domain_error if \p f has a constant that is not finite.
+
+    \pre `Type` must be a built-in floating point type.
+  */
+  template <class Func>
+  inline static std::string generate_source(const Func& f, const std::string& name)
+  {
+    static_assert(is_symbolic<Func>, "Should be called with symbolic functions!");
+    static_assert(internals::source_type_name<Type> != nullptr, "Source code can only be generated for built-in floating point types!");
+    internals::source_writer writer;
+    const std::string body = writer.expression(f);
+    const std::string type_name = internals::source_type_name<Type>;
+    return "inline " + type_name + " " + name + "(const " + type_name + "* x, const " + type_name + "* parameters)\n{\n" +
+           "  (void) x;\n  (void) parameters;\n" + writer.definitions + "  return " + body + ";\n}\n";
+  }
+}
+
+#endif
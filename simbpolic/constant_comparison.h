@@ -22,9 +22,11 @@ namespace Simbpolic
 
   template <indexer a, indexer b, indexer c, indexer d>
   SIMBPOLIC_CUDA_HOS_DEV inline static constexpr indexer compare(const Rational<a, b>& r1, const Rational<c, d>& r2)
+  //The difference is taken in the wide arithmetic, so the products of the numerators and denominators do not overflow.
   {
-    return (a * d > b * c) - (a * d < b * c);
-    //We can do this without worrying about the signs because the denominators are defined positive.
+    constexpr internals::wide_rational difference = internals::wide_rational(a, b) - internals::wide_rational(c, d);
+    static_assert(!difference.overflow, "The Rationals are too large to be compared exactly!");
+    return difference.sign();
   }
 
 
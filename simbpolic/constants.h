@@ -206,7 +206,7 @@ namespace Simbpolic
   }
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator- (const Zero& z, const Constant& other)
   {
-    return other;
+    return -other;
   }
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator* (const Zero& z, const Constant& other)
   {
@@ -482,6 +482,208 @@ namespace Simbpolic
       }
   }
     
+  namespace internals
+  {
+    /*!
+      \brief The integer type in which the arithmetic of the `Rational`s is carried out before the results are narrowed back
+             to `indexer`: 128 bits wide where the compiler provides them, `long long` otherwise.
+    */
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef __int128 wide_indexer;
+    __extension__ typedef unsigned __int128 wide_unsigned;
+#else
+    typedef long long wide_indexer;
+    typedef unsigned long long wide_unsigned;
+#endif
+
+    inline static constexpr wide_indexer wide_indexer_max = wide_indexer(~wide_unsigned(0) >> 1);
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static wide_indexer wide_abs(const wide_indexer x)
+    {
+      return (x < 0 ? -x : x);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static wide_indexer wide_gcd(wide_indexer a, wide_indexer b)
+    //std::gcd does not accept the 128-bit integers in strict standard modes.
+    {
+      a = wide_abs(a);
+      b = wide_abs(b);
+      while (b != 0)
+        {
+          const wide_indexer temp = a % b;
+          a = b;
+          b = temp;
+        }
+      return a;
+    }
+
+    /*!
+      \brief A fraction of `wide_indexer`s, always kept in lowest terms and with a positive denominator,
+             whose operations record (in `overflow`) whether any intermediate result fell outside of the range of `wide_indexer`
+             instead of silently wrapping around.
+
+      \details The operations cancel the common factors before multiplying (as in Knuth's algorithms),
+               so the intermediate results are only as large as needed, and a result that fits in `indexer`
+               never fails just because the unreduced one would not.
+    */
+    struct wide_rational
+    {
+      wide_indexer num = 0, den = 1;
+      bool overflow = false;
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr wide_rational()
+      {
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr wide_rational(const wide_indexer n, const wide_indexer d = 1, const bool over = false):
+      num(n), den(d), overflow(over || d == 0)
+      {
+        if (overflow)
+          {
+            num = 0;
+            den = 1;
+            return;
+          }
+        const wide_indexer divisor = wide_gcd(num, den);
+        num /= divisor;
+        den /= divisor;
+        if (den < 0)
+          {
+            num = -num;
+            den = -den;
+          }
+      }
+
+      /*!
+        \brief Whether the fraction is exact and both of its parts can be held by an \p Integer.
+      */
+      template <class Integer>
+      SIMBPOLIC_CUDA_HOS_DEV constexpr bool fits() const
+      {
+        return !overflow && num >= wide_indexer(std::numeric_limits<Integer>::min()) &&
+               num <= wide_indexer(std::numeric_limits<Integer>::max()) &&
+               den <= wide_indexer(std::numeric_limits<Integer>::max());
+      }
+
+      /*!
+        \brief Whether the fraction is exact and can be held by a `Rational`.
+      */
+      SIMBPOLIC_CUDA_HOS_DEV constexpr bool fits_indexer() const
+      {
+        return fits<indexer>();
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr indexer sign() const
+      {
+        return (num > 0) - (num < 0);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV static constexpr wide_indexer multiply(const wide_indexer a, const wide_indexer b, bool& over)
+      {
+        if (a == 0 || b == 0)
+          {
+            return 0;
+          }
+        else if (wide_abs(a) > wide_indexer_max / wide_abs(b))
+          {
+            over = true;
+            return 0;
+          }
+        return a * b;
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV static constexpr wide_indexer add(const wide_indexer a, const wide_indexer b, bool& over)
+      {
+        if ((b > 0 && a > wide_indexer_max - b) || (b < 0 && a < -wide_indexer_max - b))
+          {
+            over = true;
+            return 0;
+          }
+        return a + b;
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr wide_rational operator- () const
+      {
+        return wide_rational(-num, den, overflow);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr wide_rational operator+ (const wide_rational& a, const wide_rational& b)
+      {
+        bool over = a.overflow || b.overflow;
+        const wide_indexer divisor = wide_gcd(a.den, b.den);
+        const wide_indexer n = add(multiply(a.num, b.den / divisor, over), multiply(b.num, a.den / divisor, over), over);
+        const wide_indexer d = multiply(a.den / divisor, b.den, over);
+        return wide_rational(n, (over ? 1 : d), over);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr wide_rational operator- (const wide_rational& a, const wide_rational& b)
+      {
+        return a + (-b);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr wide_rational operator* (const wide_rational& a, const wide_rational& b)
+      {
+        bool over = a.overflow || b.overflow;
+        const wide_indexer first = (a.num == 0 ? 1 : wide_gcd(a.num, b.den)), second = (b.num == 0 ? 1 : wide_gcd(b.num, a.den));
+        const wide_indexer n = multiply(a.num / first, b.num / second, over);
+        const wide_indexer d = multiply(a.den / second, b.den / first, over);
+        return wide_rational(n, (over ? 1 : d), over);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr wide_rational operator/ (const wide_rational& a, const wide_rational& b)
+      {
+        return a * wide_rational(b.den, b.num, b.overflow);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr wide_rational operator^ (wide_rational base, indexer exp)
+      //As the fraction is in lowest terms, so are its powers.
+      {
+        if (exp < 0)
+          {
+            base = wide_rational(1) / base;
+            exp = -exp;
+          }
+        wide_rational ret(1);
+        while (exp)
+          {
+            if (exp & 1)
+              {
+                ret = ret * base;
+              }
+            exp = (exp >> 1);
+            if (exp)
+              {
+                base = base * base;
+              }
+          }
+        return ret;
+      }
+    };
+
+    /*!
+      \brief Gives the `Rational` (or `Zero` or `One`) with the value \p num / \p den,
+             checking that the exact result (whose parts have already been narrowed to `indexer`) did \p fit.
+
+      \remark As before the arithmetic was widened, a result of one is only `One` when the operands were integers
+              (\p integer_operands) and `Rational<1, 1>` otherwise: the integration by parts in `func_mul::primitive`
+              relies on the coefficients that cancel out keeping a type of their own,
+              or it may cycle back to the integral it started from.
+    */
+    template <bool fits, indexer num, indexer den, bool integer_operands>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto narrow_rational()
+    {
+      static_assert(fits, "The exact result does not fit in a Rational: consider a wider IntegerType in the Configuration!");
+      if constexpr (fits && num == 1 && den == 1 && !integer_operands)
+        {
+          return Rational<num, den>{};
+        }
+      else
+        {
+          return Rational<(fits ? num : 0), (fits ? den : 1)>::simplify();
+        }
+    }
+  }
+
   template <indexer num_, indexer denom_> struct Rational :
   public SymBase,
   public SymExactNumber
@@ -617,44 +819,60 @@ namespace Simbpolic
   template <indexer a, indexer b>  
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator+ (const One& one, const Rational<a, b>& r1)
   {
-    return Rational<b+a, b>::simplify();
+    constexpr internals::wide_rational result = internals::wide_rational(1) + internals::wide_rational(a, b);
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      b == 1>();
   }
   template <indexer a, indexer b>  
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator- (const One& one, const Rational<a, b>& r1)
   {
-    return Rational<b-a, b>::simplify();
+    constexpr internals::wide_rational result = internals::wide_rational(1) - internals::wide_rational(a, b);
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      b == 1>();
   }
   template <indexer a, indexer b>  
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator+ (const Rational<a, b>& r1, const One& one)
   {
-    return Rational<a+b, b>::simplify();
+    constexpr internals::wide_rational result = internals::wide_rational(a, b) + internals::wide_rational(1);
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      b == 1>();
   }
   template <indexer a, indexer b>  
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator- (const Rational<a, b>& r1, const One& one)
   {
-    return Rational<a-b, b>::simplify();
+    constexpr internals::wide_rational result = internals::wide_rational(a, b) - internals::wide_rational(1);
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      b == 1>();
   }
   
   
   template <indexer num, indexer den>  
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator- (const Rational<num, den>& r)
   {
-    return Rational<-num, den>::simplify();
+    constexpr internals::wide_rational result = -internals::wide_rational(num, den);
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      den == 1>();
   }
   template <indexer a, indexer b, indexer c, indexer d>  
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator+ (const Rational<a, b>& r1, const Rational<c, d>& r2)
   {
-    return Rational<a*d + b*c, b*d>::simplify();
+    constexpr internals::wide_rational result = internals::wide_rational(a, b) + internals::wide_rational(c, d);
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      b == 1 && d == 1>();
   }
   template <indexer a, indexer b, indexer c, indexer d, typename std::enable_if_t<a != c || b != d>* = nullptr>  
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator- (const Rational<a, b>& r1, const Rational<c, d>& r2)
   {
-    return Rational<a*d - b*c, b*d>::simplify();
+    constexpr internals::wide_rational result = internals::wide_rational(a, b) - internals::wide_rational(c, d);
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      b == 1 && d == 1>();
   }
   template <indexer a, indexer b, indexer c, indexer d>  
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator* (const Rational<a, b>& r1, const Rational<c, d>& r2)
   {
-    return Rational<a*c, b*d>::simplify();
+    constexpr internals::wide_rational result = internals::wide_rational(a, b) * internals::wide_rational(c, d);
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      b == 1 && d == 1>();
   }
   
   template <class T2, indexer a, indexer b, typename std::enable_if_t<!is_exceptional<T2> && !is_op_func<T2>>* = nullptr>  
@@ -678,7 +896,10 @@ namespace Simbpolic
   template <indexer a, indexer b, indexer c, indexer d, typename std::enable_if_t<a != c || b != d>* = nullptr>  
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator/ (const Rational<a, b>& r1, const Rational<c, d>& r2)
   {
-    return Rational<a * d * (c < 0 ? -1 : 1), b * c * (c < 0 ? -1 : 1)>{};
+    static_assert(c != 0, "Infinities not yet supported!");
+    constexpr internals::wide_rational result = internals::wide_rational(a, b) / internals::wide_rational(c, d);
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      b == 1 && (c == 1 || c == -1)>();
   }
   
   template <indexer a, indexer b>  
@@ -707,7 +928,10 @@ namespace Simbpolic
   template <indexer num, indexer den, indexer val>
   SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto operator ^ (const Rational<num, den>& r, const Intg<val>& exp)
   {
-    return Rational<fastpow(num, val), fastpow(den, val)>::simplify();
+    static_assert(num != 0 || val >= 0, "Infinities not yet supported!");
+    constexpr internals::wide_rational result = internals::wide_rational(num, den) ^ val;
+    return internals::narrow_rational<result.fits_indexer(), indexer(result.num), indexer(result.den),
+                                      den == 1 || val == 0>();
   }
 
 
@@ -0,0 +1,174 @@
+#ifndef SIMBPOLIC_CONVOLUTION
+#define SIMBPOLIC_CONVOLUTION
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static long long binomial(const indexer n, const indexer k)
+    {
+      long long ret = 1;
+      for (indexer i = 1; i <= k; ++i)
+        {
+          ret = ret * (n - k + i) / i;
+        }
+      return ret;
+    }
+
+    /*!
+      \brief Adds to \p result (of degree up to \p R) the polynomial `coefficient * x^power * (slope * x + shift)^exponent`.
+    */
+    template <indexer R>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void add_power_of_linear(exact_fraction (&result)[R + 1], const exact_fraction& coefficient,
+                                                                            const indexer power, const exact_fraction& slope,
+                                                                            const exact_fraction& shift, const indexer exponent)
+    {
+      exact_fraction slope_power(1);
+      for (indexer r = 0; r <= exponent; ++r)
+        {
+          exact_fraction shift_power(1);
+          for (indexer s = 0; s < exponent - r; ++s)
+            {
+              shift_power = shift_power * shift;
+            }
+          result[power + r] = result[power + r] + coefficient * exact_fraction(binomial(exponent, r)) * slope_power * shift_power;
+          slope_power = slope_power * slope;
+        }
+    }
+
+    /*!
+      \brief Gives the polynomial (in x) `\int_{L(x)}^{U(x)} p(t) q(x - t) dt`,
+             where the limits are `slope * x + shift` and the slopes are either 0 or 1.
+    */
+    template <indexer R, indexer D1, indexer D2>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void add_piece_convolution(exact_fraction (&result)[R + 1],
+                                                                              const exact_fraction (&p)[D1 + 1], const exact_fraction (&q)[D2 + 1],
+                                                                              const exact_fraction& lower_slope, const exact_fraction& lower_shift,
+                                                                              const exact_fraction& upper_slope, const exact_fraction& upper_shift)
+    {
+      //q(x - t) = \sum_v q_v \sum_l C(v, l) x^(v - l) (-t)^l,
+      //so p(t) q(x - t) = \sum_{px, pt} product[px][pt] x^px t^pt.
+      exact_fraction product[D2 + 1][D1 + D2 + 1] {};
+      for (indexer u = 0; u <= D1; ++u)
+        {
+          for (indexer v = 0; v <= D2; ++v)
+            {
+              for (indexer l = 0; l <= v; ++l)
+                {
+                  const exact_fraction term = p[u] * q[v] * exact_fraction(binomial(v, l) * (l % 2 ? -1 : 1));
+                  product[v - l][u + l] = product[v - l][u + l] + term;
+                }
+            }
+        }
+      for (indexer px = 0; px <= D2; ++px)
+        {
+          for (indexer pt = 0; pt <= D1 + D2; ++pt)
+            {
+              if (product[px][pt].is_zero())
+                {
+                  continue;
+                }
+              const exact_fraction coefficient = product[px][pt] / exact_fraction(pt + 1);
+              add_power_of_linear<R>(result, coefficient, px, upper_slope, upper_shift, pt + 1);
+              add_power_of_linear<R>(result, -coefficient, px, lower_slope, lower_shift, pt + 1);
+            }
+        }
+    }
+
+    /*!
+      \brief Gives the convolution of two compactly supported piecewise polynomials.
+
+      \details Every pair of pieces `p` (on `[a, b]`) and `q` (on `[c, d]`) contributes
+               `\int p(t) q(x - t) dt` over `max(a, x - d) < t < min(b, x - c)`;
+               between consecutive sums of cut-off points, which of the limits is active does not change,
+               so each contribution is a single polynomial there.
+    */
+    template <indexer C1, indexer D1, indexer C2, indexer D2>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static exact_piecewise<C1 * C2, D1 + D2 + 1> convolve_pieces(const exact_piecewise<C1, D1>& f,
+                                                                                                         const exact_piecewise<C2, D2>& g)
+    {
+      constexpr indexer D = D1 + D2 + 1;
+      exact_piecewise<C1 * C2, D> ret {};
+
+      exact_fraction sums[C1 * C2 > 0 ? C1 * C2 : 1] {};
+      indexer num_sums = 0;
+      for (indexer i = 0; i < f.num_cuts; ++i)
+        {
+          for (indexer j = 0; j < g.num_cuts; ++j)
+            {
+              sums[num_sums++] = f.cuts[i] + g.cuts[j];
+            }
+        }
+      for (indexer i = 1; i < num_sums; ++i)
+        {
+          const exact_fraction temp = sums[i];
+          indexer j = i;
+          for (; j > 0 && temp < sums[j - 1]; --j)
+            {
+              sums[j] = sums[j - 1];
+            }
+          sums[j] = temp;
+        }
+      for (indexer i = 0; i < num_sums; ++i)
+        {
+          if (ret.num_cuts == 0 || !(sums[i] == ret.cuts[ret.num_cuts - 1]))
+            {
+              ret.cuts[ret.num_cuts++] = sums[i];
+            }
+        }
+
+      for (indexer m = 1; m < ret.num_cuts; ++m)
+        //The first and last pieces are outside the support.
+        {
+          const exact_fraction x = ret.point_inside(m);
+          for (indexer i = 1; i < f.num_cuts; ++i)
+            {
+              const exact_fraction a = f.cuts[i - 1], b = f.cuts[i];
+              for (indexer j = 1; j < g.num_cuts; ++j)
+                {
+                  const exact_fraction c = g.cuts[j - 1], d = g.cuts[j];
+                  const bool fixed_lower = !(a < x - d), fixed_upper = !(x - c < b);
+                  const exact_fraction lower_at_x = (fixed_lower ? a : x - d), upper_at_x = (fixed_upper ? b : x - c);
+                  if (!(lower_at_x < upper_at_x))
+                    {
+                      continue;
+                    }
+                  add_piece_convolution<D, D1, D2>(ret.coefficients[m], f.coefficients[i], g.coefficients[j],
+                                                   exact_fraction(!fixed_lower), (fixed_lower ? a : -d),
+                                                   exact_fraction(!fixed_upper), (fixed_upper ? b : -c));
+                }
+            }
+        }
+      return ret;
+    }
+
+    template <class F, class G, indexer dim>
+    struct convolution_of
+    {
+      static_assert(exact_piecewise_of<F, dim>::value.is_compactly_supported() &&
+                    exact_piecewise_of<G, dim>::value.is_compactly_supported(),
+                    "Only functions that are zero outside of a bounded interval can be convolved!");
+      static constexpr auto value = convolve_pieces(exact_piecewise_of<F, dim>::value, exact_piecewise_of<G, dim>::value);
+    };
+  }
+
+  /*!
+    \brief Gives the convolution `\int f(t) g(x - t) dt` along \p dim,
+           as a single piecewise polynomial whose cut-off points are all the sums
+           of the cut-off points of \p f and \p g.
+
+    \remark Everything is done at compile-time, with exact arithmetic,
+            so repeated convolutions of boxes give the exact B-spline kernels.
+
+    \pre \p f and \p g must be piecewise polynomials along \p dim alone,
+         with exact coefficients and cut-off points, and they must be zero
+         before their first cut-off point and after their last one.
+  */
+  template <class F, class G, indexer dim>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto convolve(const F& f, const G& g, const Var<dim> &var)
+  {
+    return internals::from_exact_piecewise<dim, internals::convolution_of<std::decay_t<F>, std::decay_t<G>, dim>>();
+  }
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef SIMBPOLIC_CUTS
+#define SIMBPOLIC_CUTS
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    /*!
+      \brief Appends to \p cuts the numeric values of the cut-off points along \p dim
+             of all the branched functions in \p f, incrementing \p count accordingly.
+             
+      \pre \p cuts must have room for at least `cut_count<Func, dim>` more values.
+    */
+    template <indexer dim, class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void gather_cuts(const Func& f, Type* cuts, indexer& count)
+    {
+      if constexpr (cut_count<Func, dim> == 0)
+        {
+          return;
+        }
+      else if constexpr (is_op_func<Func>)
+        {
+          gather_cuts<dim>(f.f1(), cuts, count);
+          gather_cuts<dim>(f.f2(), cuts, count);
+        }
+      else if constexpr (is_interval_function<Func>)
+        {
+          if constexpr (branch_dimension<Func> == dim)
+            {
+              static_assert(!is_stored<std::decay_t<decltype(f.lower_cut())>> && !is_stored<std::decay_t<decltype(f.upper_cut())>>,
+                            "Cut-off points given by stored constants need a store to be evaluated!");
+              cuts[count++] = Type(f.lower_cut());
+              cuts[count++] = Type(f.upper_cut());
+            }
+          gather_cuts<dim>(f.f1(), cuts, count);
+          gather_cuts<dim>(f.f2(), cuts, count);
+          gather_cuts<dim>(f.f3(), cuts, count);
+        }
+      else
+        {
+          if constexpr (branch_dimension<Func> == dim)
+            {
+              static_assert(!is_stored<std::decay_t<decltype(f.cut())>>, "Cut-off points given by stored constants need a store to be evaluated!");
+              cuts[count++] = Type(f.cut());
+            }
+          gather_cuts<dim>(f.f1(), cuts, count);
+          gather_cuts<dim>(f.f2(), cuts, count);
+        }
+    }
+    
+    /*!
+      \brief Writes to \p cuts the cut-off points along \p dim of \p f,
+             sorted in increasing order and without repetitions,
+             returning how many there are.
+             
+      \pre \p cuts must have room for at least `cut_count<Func, dim>` values.
+    */
+    template <indexer dim, class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static indexer sorted_cuts(const Func& f, Type* cuts)
+    {
+      indexer count = 0;
+      gather_cuts<dim>(f, cuts, count);
+      for (indexer i = 1; i < count; ++i)
+        {
+          const Type temp = cuts[i];
+          indexer j = i;
+          for (; j > 0 && temp < cuts[j - 1]; --j)
+            {
+              cuts[j] = cuts[j - 1];
+            }
+          cuts[j] = temp;
+        }
+      indexer unique = (count > 0);
+      for (indexer i = 1; i < count; ++i)
+        {
+          if (cuts[i] != cuts[unique - 1])
+            {
+              cuts[unique++] = cuts[i];
+            }
+        }
+      return unique;
+    }
+  }
+}
+
+#endif
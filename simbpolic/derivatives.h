@@ -0,0 +1,298 @@
+#ifndef SIMBPOLIC_DERIVATIVES
+#define SIMBPOLIC_DERIVATIVES
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    /*!
+      \brief Gives `x^exp` for a jet, computing the single power `x^(exp - 2)`
+             from which the value and both derivatives of the power follow.
+    */
+    template <class Jet>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Jet power_chain(const Jet& x, const indexer exp)
+    {
+      if (exp == 0)
+        {
+          return Jet(Type(1));
+        }
+      else if (exp == 1)
+        {
+          return x;
+        }
+      else
+        {
+          const Type lower = fastpow(x.value, exp - 2);
+          const Type middle = lower * x.value;
+          return Jet::chain(x, middle * x.value, Type(exp) * middle, Type(exp) * Type(exp - 1) * lower);
+        }
+    }
+  }
+
+  /*!
+    \brief The value of a function together with its first derivatives along the first \p N dimensions.
+
+    \remark Arithmetic on these propagates the derivatives (forward-mode automatic differentiation),
+            which is how `gradient` computes everything in a single evaluation.
+  */
+  template <indexer N>
+  struct gradient_jet
+  {
+    static_assert(N > 0, "Jets need at least one dimension!");
+
+    Type value {0};
+    Type gradient[N] {};
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr gradient_jet()
+    {
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr gradient_jet(const Type& val): value(val)
+    {
+    }
+
+    /*!
+      \brief The jet of the coordinate along dimension `i + 1` at \p val.
+    */
+    SIMBPOLIC_CUDA_HOS_DEV constexpr static gradient_jet variable(const Type& val, const indexer i)
+    {
+      gradient_jet ret(val);
+      ret.gradient[i] = Type(1);
+      return ret;
+    }
+
+    /*!
+      \brief Gives `g(x)` given `g`, `g'` and `g''` at the value of \p x
+             (the latter being unused, but taken for uniformity with `hessian_jet`).
+    */
+    SIMBPOLIC_CUDA_HOS_DEV constexpr static gradient_jet chain(const gradient_jet& x, const Type& g, const Type& g_1, const Type& g_2)
+    {
+      gradient_jet ret(g);
+      for (indexer i = 0; i < N; ++i)
+        {
+          ret.gradient[i] = g_1 * x.gradient[i];
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr gradient_jet operator+ (const gradient_jet& a, const gradient_jet& b)
+    {
+      gradient_jet ret(a.value + b.value);
+      for (indexer i = 0; i < N; ++i)
+        {
+          ret.gradient[i] = a.gradient[i] + b.gradient[i];
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr gradient_jet operator- (const gradient_jet& a, const gradient_jet& b)
+    {
+      gradient_jet ret(a.value - b.value);
+      for (indexer i = 0; i < N; ++i)
+        {
+          ret.gradient[i] = a.gradient[i] - b.gradient[i];
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr gradient_jet operator* (const gradient_jet& a, const gradient_jet& b)
+    {
+      gradient_jet ret(a.value * b.value);
+      for (indexer i = 0; i < N; ++i)
+        {
+          ret.gradient[i] = a.gradient[i] * b.value + a.value * b.gradient[i];
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr gradient_jet operator/ (const gradient_jet& a, const gradient_jet& b)
+    {
+      const Type inverse = Type(1) / b.value;
+      return a * chain(b, inverse, -inverse * inverse, Type(2) * inverse * inverse * inverse);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr Type value_of(const gradient_jet& x)
+    {
+      return x.value;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr gradient_jet integer_power(const gradient_jet& x, const indexer exp)
+    {
+      return internals::power_chain(x, exp);
+    }
+  };
+
+  /*!
+    \brief The value of a function together with its first and second derivatives along the first \p N dimensions.
+  */
+  template <indexer N>
+  struct hessian_jet
+  {
+    static_assert(N > 0, "Jets need at least one dimension!");
+
+    Type value {0};
+    Type gradient[N] {};
+    Type hessian[N][N] {};
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr hessian_jet()
+    {
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr hessian_jet(const Type& val): value(val)
+    {
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr static hessian_jet variable(const Type& val, const indexer i)
+    {
+      hessian_jet ret(val);
+      ret.gradient[i] = Type(1);
+      return ret;
+    }
+
+    /*!
+      \brief Gives `g(x)` given `g`, `g'` and `g''` at the value of \p x.
+    */
+    SIMBPOLIC_CUDA_HOS_DEV constexpr static hessian_jet chain(const hessian_jet& x, const Type& g, const Type& g_1, const Type& g_2)
+    {
+      hessian_jet ret(g);
+      for (indexer i = 0; i < N; ++i)
+        {
+          ret.gradient[i] = g_1 * x.gradient[i];
+          for (indexer j = 0; j < N; ++j)
+            {
+              ret.hessian[i][j] = g_2 * x.gradient[i] * x.gradient[j] + g_1 * x.hessian[i][j];
+            }
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr hessian_jet operator+ (const hessian_jet& a, const hessian_jet& b)
+    {
+      hessian_jet ret(a.value + b.value);
+      for (indexer i = 0; i < N; ++i)
+        {
+          ret.gradient[i] = a.gradient[i] + b.gradient[i];
+          for (indexer j = 0; j < N; ++j)
+            {
+              ret.hessian[i][j] = a.hessian[i][j] + b.hessian[i][j];
+            }
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr hessian_jet operator- (const hessian_jet& a, const hessian_jet& b)
+    {
+      hessian_jet ret(a.value - b.value);
+      for (indexer i = 0; i < N; ++i)
+        {
+          ret.gradient[i] = a.gradient[i] - b.gradient[i];
+          for (indexer j = 0; j < N; ++j)
+            {
+              ret.hessian[i][j] = a.hessian[i][j] - b.hessian[i][j];
+            }
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr hessian_jet operator* (const hessian_jet& a, const hessian_jet& b)
+    {
+      hessian_jet ret(a.value * b.value);
+      for (indexer i = 0; i < N; ++i)
+        {
+          ret.gradient[i] = a.gradient[i] * b.value + a.value * b.gradient[i];
+          for (indexer j = 0; j < N; ++j)
+            {
+              ret.hessian[i][j] = a.hessian[i][j] * b.value + a.gradient[i] * b.gradient[j] +
+                                  b.gradient[i] * a.gradient[j] + a.value * b.hessian[i][j];
+            }
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr hessian_jet operator/ (const hessian_jet& a, const hessian_jet& b)
+    {
+      const Type inverse = Type(1) / b.value;
+      return a * chain(b, inverse, -inverse * inverse, Type(2) * inverse * inverse * inverse);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr Type value_of(const hessian_jet& x)
+    {
+      return x.value;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr hessian_jet integer_power(const hessian_jet& x, const indexer exp)
+    {
+      return internals::power_chain(x, exp);
+    }
+  };
+
+  namespace internals
+  {
+    template <class Jet, class Func, class ... Args, std::size_t ... idx>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Jet evaluate_jet(const Func& f, std::index_sequence<idx...>, const Args& ... args)
+    {
+      const Jet point[sizeof...(Args)] = {Jet::variable(Type(args), indexer(idx))...};
+      return evaluate_with(f, point);
+    }
+  }
+
+  /*!
+    \brief Holds a function whose value and first derivatives are evaluated together,
+           giving a `gradient_jet` over all of its dimensions.
+  */
+  template <class Func>
+  struct gradient_function
+  {
+    Func f;
+
+    template <class ... Args>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr gradient_jet<Func::max_dimension> operator() (const Args& ... args) const
+    {
+      static_assert(sizeof...(Args) == Func::max_dimension, "There must be a value for every dimension of the function!");
+      return internals::evaluate_jet<gradient_jet<Func::max_dimension>>(f, std::index_sequence_for<Args...>{}, args...);
+    }
+  };
+
+  /*!
+    \brief Holds a function whose value, first and second derivatives are evaluated together,
+           giving a `hessian_jet` over all of its dimensions.
+  */
+  template <class Func>
+  struct hessian_function
+  {
+    Func f;
+
+    template <class ... Args>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr hessian_jet<Func::max_dimension> operator() (const Args& ... args) const
+    {
+      static_assert(sizeof...(Args) == Func::max_dimension, "There must be a value for every dimension of the function!");
+      return internals::evaluate_jet<hessian_jet<Func::max_dimension>>(f, std::index_sequence_for<Args...>{}, args...);
+    }
+  };
+
+  /*!
+    \brief Gives something that evaluates \p f and all its first derivatives at once.
+
+    \remark Unlike evaluating each `derivative<d>()` separately, the powers of each monomial
+            and the choice of the piece of each branched function are only computed once per evaluation.
+            As with the derivatives themselves, the jumps at the cut-off points are not taken into account.
+  */
+  template <class Func>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto gradient(const Func& f)
+  {
+    return gradient_function<Func>{f};
+  }
+
+  /*!
+    \brief Gives something that evaluates \p f, its first and its second derivatives at once.
+
+    \remark Same as `gradient`, with the second derivatives also being computed in the same pass.
+  */
+  template <class Func>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto hessian(const Func& f)
+  {
+    return hessian_function<Func>{f};
+  }
+}
+
+#endif
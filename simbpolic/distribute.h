@@ -0,0 +1,56 @@
+#ifndef SIMBPOLIC_DISTRIBUTE
+#define SIMBPOLIC_DISTRIBUTE
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    /*!
+      \brief The largest expression (in number of nodes, see `expression_size`)
+             that `distribute_fully` (and thus `integrate`) will accept as the result of a pass, by default.
+    */
+    inline static constexpr indexer distribute_node_budget = 256;
+
+    /*!
+      \brief The largest number of passes `distribute_fully` goes through.
+    */
+    inline static constexpr indexer distribute_max_passes = 16;
+
+    template <indexer node_budget, indexer passes_left, class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto distribute_fully_impl(const Func& f)
+    {
+      const auto next = Simbpolic::distribute<expression_depth<Func>>(f);
+      using Next = std::decay_t<decltype(next)>;
+      
+      if constexpr (std::is_same_v<Next, Func> || expression_size<Next> > node_budget)
+        {
+          return f;
+        }
+      else if constexpr (passes_left <= 1)
+        {
+          return next;
+        }
+      else
+        {
+          return distribute_fully_impl<node_budget, passes_left - 1>(next);
+        }
+    }
+  }
+  
+  /*!
+    \brief Distributes multiplications and divisions over sums
+           until the expression stops changing.
+    
+    \remark Each pass goes through the whole tree (so there is no need
+            to guess a recursion count, as with `distribute<recurse_count>`).
+            If a pass would yield an expression with more than \p node_budget nodes,
+            the result of the previous pass is returned instead.
+  */
+  template <indexer node_budget = internals::distribute_node_budget, class Func>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto distribute_fully(const Func& f)
+  {
+    return internals::distribute_fully_impl<node_budget, internals::distribute_max_passes>(f);
+  }
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef SIMBPOLIC_DUAL
+#define SIMBPOLIC_DUAL
+
+#include <type_traits>
+
+#include "platform.h"
+
+namespace Simbpolic
+{
+  /*!
+    \brief A dual number `value + derivative * epsilon`, with `epsilon^2 = 0`,
+           meant to be used as the `ResultType` of the `Configuration`
+           so that evaluating a function also gives its derivative along some direction.
+
+    \details To get the derivative along the dimension `d`, evaluate the function
+             with `dual<T>::variable(x_d)` for that dimension and plain values for the others.
+             All comparisons (and thus the choice of the pieces of branched functions)
+             only take the value into account.
+
+    \remark Since it does not depend on the rest of the library,
+            this header can (and should) be included before declaring the `Configuration`:
+~~~~~~{cpp}
+#include "simbpolic/dual.h"
+
+namespace Simbpolic
+{
+  class Configuration
+  {
+    public:
+      using ResultType = dual<double>;
+  };
+}
+
+#include "simbpolic.h"
+~~~~~~
+  */
+  template <class T>
+  struct dual
+  {
+    T value {0}, derivative {0};
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dual()
+    {
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dual(const T& val, const T& deriv = T(0)): value(val), derivative(deriv)
+    {
+    }
+
+    template <class Num, typename std::enable_if_t<std::is_arithmetic_v<Num> && !std::is_same_v<Num, T>>* = nullptr>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dual(const Num& val): value(T(val))
+    {
+    }
+
+    /*!
+      \brief The dual number for the variable with respect to which we differentiate, at \p val.
+    */
+    SIMBPOLIC_CUDA_HOS_DEV constexpr static dual variable(const T& val)
+    {
+      return dual(val, T(1));
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dual operator+ () const
+    {
+      return *this;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dual operator- () const
+    {
+      return dual(-value, -derivative);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr dual operator+ (const dual& a, const dual& b)
+    {
+      return dual(a.value + b.value, a.derivative + b.derivative);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr dual operator- (const dual& a, const dual& b)
+    {
+      return dual(a.value - b.value, a.derivative - b.derivative);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr dual operator* (const dual& a, const dual& b)
+    {
+      return dual(a.value * b.value, a.derivative * b.value + a.value * b.derivative);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr dual operator/ (const dual& a, const dual& b)
+    {
+      return dual(a.value / b.value, (a.derivative * b.value - a.value * b.derivative) / (b.value * b.value));
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dual& operator+= (const dual& other)
+    {
+      return (*this = *this + other);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dual& operator-= (const dual& other)
+    {
+      return (*this = *this - other);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dual& operator*= (const dual& other)
+    {
+      return (*this = *this * other);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dual& operator/= (const dual& other)
+    {
+      return (*this = *this / other);
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr bool operator< (const dual& a, const dual& b)
+    {
+      return a.value < b.value;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr bool operator> (const dual& a, const dual& b)
+    {
+      return a.value > b.value;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr bool operator<= (const dual& a, const dual& b)
+    {
+      return a.value <= b.value;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr bool operator>= (const dual& a, const dual& b)
+    {
+      return a.value >= b.value;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr bool operator== (const dual& a, const dual& b)
+    {
+      return a.value == b.value;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr bool operator!= (const dual& a, const dual& b)
+    {
+      return a.value != b.value;
+    }
+
+    template <class Stream>
+    friend Stream& operator<< (Stream& s, const dual& d)
+    {
+      s << d.value << " + " << d.derivative << " \\epsilon";
+      return s;
+    }
+  };
+}
+
+#endif
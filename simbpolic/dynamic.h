@@ -0,0 +1,958 @@
+#ifndef SIMBPOLIC_DYNAMIC
+#define SIMBPOLIC_DYNAMIC
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+
+#include "../simbpolic.h"
+
+namespace Simbpolic
+{
+  enum class dynamic_kind
+  {
+    rational, constant, stored, monomial, add, subtract, multiply, divide, piecewise
+  };
+
+  /*!
+    \brief A node of an expression whose shape is only known at run-time,
+           owned by the `dynamic_arena` that built it.
+
+    \details Nodes are hash-consed: an arena never holds two nodes with the same contents,
+             so equal subexpressions are shared and can be compared by their address.
+             The meaning of the members depends on the kind:
+               - `rational`: `exact` holds the value;
+               - `constant`: `value` holds the value;
+               - `stored`: `index` is the `i` of `Stored<i>`;
+               - `monomial`: `x_dim ^ index`;
+               - `add`, `subtract`, `multiply` and `divide`: the two `operands`;
+               - `piecewise`: a piecewise function along `dim`, with `num_cuts` cut-off points
+                 (which are rationals, constants or stored constants, in increasing order);
+                 `operands` holds the `num_cuts + 1` pieces, followed by the cut-off points.
+
+    \remark Dimensions go from 1 to 64, since the dimensions a node depends on are kept as bit masks.
+  */
+  struct dynamic_node
+  {
+    dynamic_kind kind = dynamic_kind::rational;
+    indexer dim = 0, index = 0, num_cuts = 0;
+    internals::exact_fraction exact {};
+    Type value {};
+    const dynamic_node* const* operands = nullptr;
+    std::uint64_t dimensions = 0, cut_dimensions = 0;
+    //Bit `d - 1` is set if the node depends on `x_d` (or has cut-off points along it).
+    indexer stored_count = 0;
+    std::size_t hash = 0;
+
+    indexer num_operands() const
+    {
+      switch (kind)
+        {
+          case dynamic_kind::add:
+          case dynamic_kind::subtract:
+          case dynamic_kind::multiply:
+          case dynamic_kind::divide:
+            return 2;
+          case dynamic_kind::piecewise:
+            return 2 * num_cuts + 1;
+          default:
+            return 0;
+        }
+    }
+
+    bool has_dimension(const indexer d) const
+    {
+      return (dimensions >> (d - 1)) & 1;
+    }
+
+    bool has_cuts(const indexer d) const
+    {
+      return (cut_dimensions >> (d - 1)) & 1;
+    }
+
+    indexer max_dimension() const
+    {
+      indexer ret = 0;
+      for (std::uint64_t mask = dimensions; mask != 0; mask >>= 1)
+        {
+          ++ret;
+        }
+      return ret;
+    }
+
+    bool is_number() const
+    {
+      return kind == dynamic_kind::rational || kind == dynamic_kind::constant;
+    }
+
+    Type number() const
+    {
+      return (kind == dynamic_kind::rational ? Type(exact.num) / Type(exact.den) : value);
+    }
+
+    const dynamic_node* piece(const indexer i) const
+    {
+      return operands[i];
+    }
+
+    const dynamic_node* cut(const indexer i) const
+    {
+      return operands[num_cuts + 1 + i];
+    }
+  };
+
+  namespace internals
+  {
+    inline static Type dynamic_cut_value(const dynamic_node* cut, const Type* parameters)
+    {
+      if (cut->kind == dynamic_kind::stored)
+        {
+          if (parameters == nullptr)
+            {
+              throw std::invalid_argument("Stored constants need parameters to be evaluated!");
+            }
+          return parameters[cut->index];
+        }
+      return cut->number();
+    }
+
+    inline static wide_rational wide_fraction(const exact_fraction& x)
+    {
+      return wide_rational(x.num, x.den);
+    }
+
+    inline static int compare_numbers(const dynamic_node* a, const dynamic_node* b)
+    //Exact whenever both are rational (the difference is taken in the checked wide arithmetic).
+    {
+      if (a->kind == dynamic_kind::rational && b->kind == dynamic_kind::rational)
+        {
+          const wide_rational difference = wide_fraction(a->exact) - wide_fraction(b->exact);
+          if (!difference.overflow)
+            {
+              return difference.sign();
+            }
+        }
+      const Type x = a->number(), y = b->number();
+      return (x < y ? -1 : (x == y ? 0 : 1));
+    }
+
+    inline static indexer dynamic_degree(const dynamic_node* f, const indexer dim, std::unordered_map<const dynamic_node*, indexer>& memo)
+    //The highest power of `x_dim` in f, or -1 if it is not a polynomial along dim (in each of its pieces).
+    //Since nodes are shared, the degree of each one is kept in memo (which must only be used for the same dim).
+    {
+      if (!f->has_dimension(dim))
+        {
+          return 0;
+        }
+      const auto found = memo.find(f);
+      if (found != memo.end())
+        {
+          return found->second;
+        }
+      indexer ret = 0;
+      switch (f->kind)
+        {
+          case dynamic_kind::monomial:
+            ret = (f->index < 0 ? -1 : f->index);
+            break;
+          case dynamic_kind::add:
+          case dynamic_kind::subtract:
+            ret = internals::degree_of_sum(dynamic_degree(f->operands[0], dim, memo), dynamic_degree(f->operands[1], dim, memo));
+            break;
+          case dynamic_kind::multiply:
+            ret = internals::degree_of_product(dynamic_degree(f->operands[0], dim, memo), dynamic_degree(f->operands[1], dim, memo));
+            break;
+          case dynamic_kind::divide:
+            ret = (f->operands[1]->has_dimension(dim) ? -1 : dynamic_degree(f->operands[0], dim, memo));
+            break;
+          case dynamic_kind::piecewise:
+            for (indexer i = 0; i <= f->num_cuts; ++i)
+              {
+                ret = internals::degree_of_sum(ret, dynamic_degree(f->piece(i), dim, memo));
+              }
+            break;
+          default:
+            break;
+        }
+      memo[f] = ret;
+      return ret;
+    }
+
+    inline static indexer dynamic_degree(const dynamic_node* f, const indexer dim)
+    {
+      std::unordered_map<const dynamic_node*, indexer> memo;
+      return dynamic_degree(f, dim, memo);
+    }
+
+    inline static std::size_t hash_combine(const std::size_t seed, const std::size_t value)
+    {
+      return (seed ^ value) * std::size_t(1099511628211ull);
+    }
+  }
+
+  /*!
+    \brief Evaluates \p f at \p point (with `point[d - 1]` being the value of `x_d`),
+           taking the value of `Stored<i>` from `parameters[i]`.
+
+    \remark As with the expression templates, only the piece of each piecewise function that contains the point
+            is evaluated, and the average of both sides is taken at the cut-off points.
+  */
+  inline static Type evaluate_dynamic(const dynamic_node* f, const Type* point, const Type* parameters = nullptr)
+  {
+    switch (f->kind)
+      {
+        case dynamic_kind::rational:
+        case dynamic_kind::constant:
+          return f->number();
+        case dynamic_kind::stored:
+          return internals::dynamic_cut_value(f, parameters);
+        case dynamic_kind::monomial:
+          return fastpow(point[f->dim - 1], f->index);
+        case dynamic_kind::add:
+          return evaluate_dynamic(f->operands[0], point, parameters) + evaluate_dynamic(f->operands[1], point, parameters);
+        case dynamic_kind::subtract:
+          return evaluate_dynamic(f->operands[0], point, parameters) - evaluate_dynamic(f->operands[1], point, parameters);
+        case dynamic_kind::multiply:
+          return evaluate_dynamic(f->operands[0], point, parameters) * evaluate_dynamic(f->operands[1], point, parameters);
+        case dynamic_kind::divide:
+          return evaluate_dynamic(f->operands[0], point, parameters) / evaluate_dynamic(f->operands[1], point, parameters);
+        default:
+          {
+            const Type x = point[f->dim - 1];
+            for (indexer i = 0; i < f->num_cuts; ++i)
+              {
+                const Type cut = internals::dynamic_cut_value(f->cut(i), parameters);
+                if (x < cut)
+                  {
+                    return evaluate_dynamic(f->piece(i), point, parameters);
+                  }
+                else if (x == cut)
+                  {
+                    return (evaluate_dynamic(f->piece(i), point, parameters) + evaluate_dynamic(f->piece(i + 1), point, parameters)) / Type(2);
+                  }
+              }
+            return evaluate_dynamic(f->piece(f->num_cuts), point, parameters);
+          }
+      }
+  }
+
+  /*!
+    \brief Builds and owns runtime expressions (see `dynamic_node`),
+           allocating them from large blocks that are only released when the arena is destroyed.
+
+    \details Every node goes through a hash table first, so building an expression that already exists
+             gives back the existing node. The same simplifications as with the expression templates
+             (with zeros, ones and operations between numbers) are applied while building.
+             `primitive`, `derivative`, `evaluate_along` and `integrate` follow the semantics of the
+             corresponding member functions of the expression templates:
+             the primitives of piecewise functions along the integration variable are made continuous
+             across the cut-off points, and the cut-off points are considered fixed when differentiating.
+
+    \remark The operations that cannot be done symbolically (such as integrating a quotient
+            that depends on the integration variable) throw `std::domain_error`;
+            malformed expressions throw `std::invalid_argument`.
+
+    \pre `Type` must be trivially destructible, since the nodes are never destroyed individually.
+  */
+  class dynamic_arena
+  {
+    public:
+
+    using node = const dynamic_node*;
+
+    explicit dynamic_arena(const std::size_t block_size = 65536): m_block_size(block_size), m_table(1024, nullptr)
+    {
+    }
+
+    dynamic_arena(const dynamic_arena&) = delete;
+    dynamic_arena& operator= (const dynamic_arena&) = delete;
+
+    /*!
+      \brief The number of bytes taken from the blocks so far.
+    */
+    std::size_t bytes_used() const
+    {
+      return m_used;
+    }
+
+    std::size_t node_count() const
+    {
+      return m_count;
+    }
+
+    node rational(const long long num, const long long den = 1)
+    {
+      if (den == 0)
+        {
+          throw std::domain_error("Division by zero!");
+        }
+      dynamic_node candidate;
+      candidate.kind = dynamic_kind::rational;
+      candidate.exact = internals::exact_fraction(num, den);
+      return intern(candidate, nullptr);
+    }
+
+    node constant(const Type& val)
+    {
+      dynamic_node candidate;
+      candidate.kind = dynamic_kind::constant;
+      candidate.value = val;
+      return intern(candidate, nullptr);
+    }
+
+    node stored(const indexer idx)
+    {
+      if (idx < 0)
+        {
+          throw std::invalid_argument("Constant indices cannot be negative!");
+        }
+      dynamic_node candidate;
+      candidate.kind = dynamic_kind::stored;
+      candidate.index = idx;
+      candidate.stored_count = idx + 1;
+      return intern(candidate, nullptr);
+    }
+
+    node monomial(const indexer order, const indexer dim)
+    {
+      check_dimension(dim);
+      if (order == 0)
+        {
+          return rational(1);
+        }
+      dynamic_node candidate;
+      candidate.kind = dynamic_kind::monomial;
+      candidate.index = order;
+      candidate.dim = dim;
+      candidate.dimensions = std::uint64_t(1) << (dim - 1);
+      return intern(candidate, nullptr);
+    }
+
+    node variable(const indexer dim)
+    {
+      return monomial(1, dim);
+    }
+
+    node add(node a, node b)
+    {
+      if (is_zero(a))
+        {
+          return b;
+        }
+      else if (is_zero(b))
+        {
+          return a;
+        }
+      else if (a->kind == dynamic_kind::rational && b->kind == dynamic_kind::rational)
+        {
+          return exact_number(internals::wide_fraction(a->exact) + internals::wide_fraction(b->exact),
+                              a->number() + b->number());
+        }
+      else if (a->is_number() && b->is_number())
+        {
+          return constant(a->number() + b->number());
+        }
+      return binary(dynamic_kind::add, a, b);
+    }
+
+    node subtract(node a, node b)
+    {
+      if (is_zero(b))
+        {
+          return a;
+        }
+      else if (a == b)
+        {
+          return rational(0);
+        }
+      else if (a->kind == dynamic_kind::rational && b->kind == dynamic_kind::rational)
+        {
+          return exact_number(internals::wide_fraction(a->exact) - internals::wide_fraction(b->exact),
+                              a->number() - b->number());
+        }
+      else if (a->is_number() && b->is_number())
+        {
+          return constant(a->number() - b->number());
+        }
+      return binary(dynamic_kind::subtract, a, b);
+    }
+
+    node multiply(node a, node b)
+    {
+      if (is_zero(a) || is_zero(b))
+        {
+          return rational(0);
+        }
+      else if (is_one(a))
+        {
+          return b;
+        }
+      else if (is_one(b))
+        {
+          return a;
+        }
+      else if (a->kind == dynamic_kind::rational && b->kind == dynamic_kind::rational)
+        {
+          return exact_number(internals::wide_fraction(a->exact) * internals::wide_fraction(b->exact),
+                              a->number() * b->number());
+        }
+      else if (a->is_number() && b->is_number())
+        {
+          return constant(a->number() * b->number());
+        }
+      return binary(dynamic_kind::multiply, a, b);
+    }
+
+    node divide(node a, node b)
+    {
+      if (is_zero(b))
+        {
+          throw std::domain_error("Division by zero!");
+        }
+      else if (is_zero(a))
+        {
+          return a;
+        }
+      else if (is_one(b))
+        {
+          return a;
+        }
+      else if (a->kind == dynamic_kind::rational && b->kind == dynamic_kind::rational)
+        {
+          return exact_number(internals::wide_fraction(a->exact) / internals::wide_fraction(b->exact),
+                              a->number() / b->number());
+        }
+      else if (a->is_number() && b->is_number())
+        {
+          return constant(a->number() / b->number());
+        }
+      return binary(dynamic_kind::divide, a, b);
+    }
+
+    /*!
+      \brief The function that is `pieces[0]` for `x_dim < cuts[0]`, `pieces[i]` for `cuts[i - 1] < x_dim < cuts[i]`
+             and `pieces.back()` for `x_dim > cuts.back()`.
+
+      \pre The cut-off points must be numbers or stored constants, and those that are numbers must be increasing.
+    */
+    node piecewise(const indexer dim, const std::vector<node>& cuts, const std::vector<node>& pieces)
+    {
+      check_dimension(dim);
+      if (pieces.size() != cuts.size() + 1)
+        {
+          throw std::invalid_argument("There must be one more piece than cut-off points!");
+        }
+      node last_number = nullptr;
+      for (node cut : cuts)
+        {
+          if (!cut->is_number() && cut->kind != dynamic_kind::stored)
+            {
+              throw std::invalid_argument("The cut-off points must be numbers or stored constants!");
+            }
+          if (cut->is_number())
+            {
+              if (last_number != nullptr && internals::compare_numbers(last_number, cut) >= 0)
+                {
+                  throw std::invalid_argument("The cut-off points must be increasing!");
+                }
+              last_number = cut;
+            }
+        }
+      bool all_same = true;
+      for (node p : pieces)
+        {
+          all_same = all_same && (p == pieces[0]);
+        }
+      if (all_same)
+        {
+          return pieces[0];
+        }
+
+      std::vector<node> ops(pieces);
+      ops.insert(ops.end(), cuts.begin(), cuts.end());
+      dynamic_node candidate;
+      candidate.kind = dynamic_kind::piecewise;
+      candidate.dim = dim;
+      candidate.num_cuts = indexer(cuts.size());
+      candidate.dimensions = candidate.cut_dimensions = std::uint64_t(1) << (dim - 1);
+      return intern(candidate, ops.data());
+    }
+
+    /*!
+      \brief The derivative of \p f along \p dim.
+    */
+    node derivative(node f, const indexer dim)
+    {
+      check_dimension(dim);
+      std::unordered_map<node, node> memo;
+      return derivative_of(f, dim, memo);
+    }
+
+    /*!
+      \brief A primitive of \p f along \p dim.
+    */
+    node primitive(node f, const indexer dim)
+    {
+      check_dimension(dim);
+      std::unordered_map<node, node> memo;
+      return primitive_of(f, dim, memo);
+    }
+
+    /*!
+      \brief \p f with `x_dim` replaced by \p value.
+
+      \remark Piecewise functions along \p dim can only be resolved if \p value and their cut-off points are numbers.
+    */
+    node evaluate_along(node f, const indexer dim, node value)
+    {
+      check_dimension(dim);
+      std::unordered_map<node, node> memo;
+      return substitute(f, dim, value, memo);
+    }
+
+    /*!
+      \brief The integral of \p f along \p dim from \p start to \p end.
+    */
+    node integrate(node f, const indexer dim, node start, node end)
+    {
+      const node prim = primitive(f, dim);
+      return subtract(evaluate_along(prim, dim, end), evaluate_along(prim, dim, start));
+    }
+
+    /*!
+      \brief The highest power of `x_dim` in \p f, or -1 if it is not a polynomial along \p dim
+             (in each of its pieces).
+    */
+    indexer polynomial_degree(node f, const indexer dim) const
+    {
+      return internals::dynamic_degree(f, dim);
+    }
+
+    private:
+
+    std::size_t m_block_size, m_offset = 0, m_used = 0, m_count = 0;
+    std::vector<std::unique_ptr<unsigned char[]>> m_blocks;
+    std::size_t m_current_size = 0;
+    std::vector<node> m_table;
+
+    static void check_dimension(const indexer dim)
+    {
+      if (dim < 1 || dim > 64)
+        {
+          throw std::invalid_argument("Dimensions must go from 1 to 64!");
+        }
+    }
+
+    static bool is_zero(node f)
+    {
+      return (f->kind == dynamic_kind::rational && f->exact.num == 0);
+    }
+
+    static bool is_one(node f)
+    {
+      return (f->kind == dynamic_kind::rational && f->exact.num == 1 && f->exact.den == 1);
+    }
+
+    node exact_number(const internals::wide_rational& x, const Type& approximation)
+    //The arithmetic of the rationals is checked, as overflowing at run-time would silently give wrong results:
+    //when the exact result does not fit in the fractions of the nodes, the approximation is kept as a constant.
+    {
+      if (x.template fits<long long>())
+        {
+          return rational((long long) x.num, (long long) x.den);
+        }
+      return constant(approximation);
+    }
+
+    void* allocate(const std::size_t bytes, const std::size_t alignment)
+    {
+      std::size_t start = (m_offset + alignment - 1) / alignment * alignment;
+      if (m_blocks.empty() || start + bytes > m_current_size)
+        {
+          m_current_size = (bytes + alignment > m_block_size ? bytes + alignment : m_block_size);
+          m_blocks.emplace_back(new unsigned char[m_current_size]);
+          m_offset = 0;
+          const std::size_t base = reinterpret_cast<std::uintptr_t>(m_blocks.back().get());
+          start = (base + alignment - 1) / alignment * alignment - base;
+        }
+      m_used += start - m_offset + bytes;
+      m_offset = start + bytes;
+      return m_blocks.back().get() + start;
+    }
+
+    static std::size_t hash_of(const dynamic_node& candidate, const node* ops)
+    {
+      std::size_t ret = std::size_t(14695981039346656037ull);
+      ret = internals::hash_combine(ret, std::size_t(candidate.kind));
+      ret = internals::hash_combine(ret, std::size_t(candidate.dim));
+      ret = internals::hash_combine(ret, std::size_t(candidate.index));
+      ret = internals::hash_combine(ret, std::size_t(candidate.num_cuts));
+      ret = internals::hash_combine(ret, std::size_t(candidate.exact.num));
+      ret = internals::hash_combine(ret, std::size_t(candidate.exact.den));
+      unsigned char bytes[sizeof(Type)] {};
+      std::memcpy(bytes, &candidate.value, sizeof(Type));
+      for (unsigned char c : bytes)
+        {
+          ret = internals::hash_combine(ret, c);
+        }
+      for (indexer i = 0; i < candidate.num_operands(); ++i)
+        {
+          ret = internals::hash_combine(ret, std::size_t(reinterpret_cast<std::uintptr_t>(ops[i])));
+        }
+      return ret;
+    }
+
+    static bool same_node(const dynamic_node& candidate, const node* ops, node other)
+    {
+      if (candidate.hash != other->hash || candidate.kind != other->kind || candidate.dim != other->dim ||
+          candidate.index != other->index || candidate.num_cuts != other->num_cuts ||
+          !(candidate.exact == other->exact) || !(candidate.value == other->value))
+        {
+          return false;
+        }
+      for (indexer i = 0; i < candidate.num_operands(); ++i)
+        {
+          if (ops[i] != other->operands[i])
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+
+    void insert(node n)
+    {
+      const std::size_t mask = m_table.size() - 1;
+      std::size_t pos = n->hash & mask;
+      while (m_table[pos] != nullptr)
+        {
+          pos = (pos + 1) & mask;
+        }
+      m_table[pos] = n;
+    }
+
+    node intern(dynamic_node& candidate, const node* ops)
+    //Gives the existing node equal to candidate (with operands ops), or copies it to the arena.
+    {
+      const indexer num_ops = candidate.num_operands();
+      for (indexer i = 0; i < num_ops; ++i)
+        {
+          candidate.dimensions |= ops[i]->dimensions;
+          candidate.cut_dimensions |= ops[i]->cut_dimensions;
+          candidate.stored_count = internals::max_of(candidate.stored_count, ops[i]->stored_count);
+        }
+      candidate.hash = hash_of(candidate, ops);
+
+      const std::size_t mask = m_table.size() - 1;
+      for (std::size_t pos = candidate.hash & mask; m_table[pos] != nullptr; pos = (pos + 1) & mask)
+        {
+          if (same_node(candidate, ops, m_table[pos]))
+            {
+              return m_table[pos];
+            }
+        }
+
+      if (num_ops > 0)
+        {
+          node* stored_ops = static_cast<node*>(allocate(sizeof(node) * std::size_t(num_ops), alignof(node)));
+          for (indexer i = 0; i < num_ops; ++i)
+            {
+              stored_ops[i] = ops[i];
+            }
+          candidate.operands = stored_ops;
+        }
+      dynamic_node* ret = new (allocate(sizeof(dynamic_node), alignof(dynamic_node))) dynamic_node(candidate);
+
+      if (2 * (m_count + 1) > m_table.size())
+        {
+          std::vector<node> old(2 * m_table.size(), nullptr);
+          old.swap(m_table);
+          for (node n : old)
+            {
+              if (n != nullptr)
+                {
+                  insert(n);
+                }
+            }
+        }
+      insert(ret);
+      ++m_count;
+      return ret;
+    }
+
+    node binary(const dynamic_kind kind, node a, node b)
+    {
+      const node ops[2] = {a, b};
+      dynamic_node candidate;
+      candidate.kind = kind;
+      return intern(candidate, ops);
+    }
+
+    node with_pieces(node f, const std::vector<node>& pieces)
+    //The piecewise function f with its pieces replaced.
+    {
+      std::vector<node> cuts(std::size_t(f->num_cuts));
+      for (indexer i = 0; i < f->num_cuts; ++i)
+        {
+          cuts[i] = f->cut(i);
+        }
+      return piecewise(f->dim, cuts, pieces);
+    }
+
+    node power(node base, const indexer exp)
+    {
+      if (exp < 0)
+        {
+          return divide(rational(1), power(base, -exp));
+        }
+      node ret = rational(1), factor = base;
+      for (indexer e = exp; e > 0; e >>= 1)
+        {
+          if (e & 1)
+            {
+              ret = multiply(ret, factor);
+            }
+          if (e > 1)
+            {
+              factor = multiply(factor, factor);
+            }
+        }
+      return ret;
+    }
+
+    node derivative_of(node f, const indexer dim, std::unordered_map<node, node>& memo)
+    {
+      if (!f->has_dimension(dim))
+        {
+          return rational(0);
+        }
+      const auto found = memo.find(f);
+      if (found != memo.end())
+        {
+          return found->second;
+        }
+      node ret = nullptr;
+      switch (f->kind)
+        {
+          case dynamic_kind::monomial:
+            ret = multiply(rational(f->index), monomial(f->index - 1, dim));
+            break;
+          case dynamic_kind::add:
+            ret = add(derivative_of(f->operands[0], dim, memo), derivative_of(f->operands[1], dim, memo));
+            break;
+          case dynamic_kind::subtract:
+            ret = subtract(derivative_of(f->operands[0], dim, memo), derivative_of(f->operands[1], dim, memo));
+            break;
+          case dynamic_kind::multiply:
+            {
+              node a = f->operands[0], b = f->operands[1];
+              ret = add(multiply(derivative_of(a, dim, memo), b), multiply(a, derivative_of(b, dim, memo)));
+              break;
+            }
+          case dynamic_kind::divide:
+            {
+              node a = f->operands[0], b = f->operands[1];
+              ret = divide(subtract(multiply(derivative_of(a, dim, memo), b), multiply(a, derivative_of(b, dim, memo))), multiply(b, b));
+              break;
+            }
+          default:
+            {
+              std::vector<node> pieces(std::size_t(f->num_cuts) + 1);
+              for (indexer i = 0; i <= f->num_cuts; ++i)
+                {
+                  pieces[i] = derivative_of(f->piece(i), dim, memo);
+                }
+              ret = with_pieces(f, pieces);
+              break;
+            }
+        }
+      memo[f] = ret;
+      return ret;
+    }
+
+    node substitute(node f, const indexer dim, node value, std::unordered_map<node, node>& memo)
+    {
+      if (!f->has_dimension(dim))
+        {
+          return f;
+        }
+      const auto found = memo.find(f);
+      if (found != memo.end())
+        {
+          return found->second;
+        }
+      node ret = nullptr;
+      switch (f->kind)
+        {
+          case dynamic_kind::monomial:
+            ret = power(value, f->index);
+            break;
+          case dynamic_kind::add:
+            ret = add(substitute(f->operands[0], dim, value, memo), substitute(f->operands[1], dim, value, memo));
+            break;
+          case dynamic_kind::subtract:
+            ret = subtract(substitute(f->operands[0], dim, value, memo), substitute(f->operands[1], dim, value, memo));
+            break;
+          case dynamic_kind::multiply:
+            ret = multiply(substitute(f->operands[0], dim, value, memo), substitute(f->operands[1], dim, value, memo));
+            break;
+          case dynamic_kind::divide:
+            ret = divide(substitute(f->operands[0], dim, value, memo), substitute(f->operands[1], dim, value, memo));
+            break;
+          default:
+            if (f->dim != dim)
+              {
+                std::vector<node> pieces(std::size_t(f->num_cuts) + 1);
+                for (indexer i = 0; i <= f->num_cuts; ++i)
+                  {
+                    pieces[i] = substitute(f->piece(i), dim, value, memo);
+                  }
+                ret = with_pieces(f, pieces);
+              }
+            else
+              {
+                if (!value->is_number())
+                  {
+                    throw std::domain_error("Piecewise functions can only be evaluated along their dimension at numbers!");
+                  }
+                indexer i = 0;
+                int comparison = 1;
+                for (; i < f->num_cuts; ++i)
+                  {
+                    if (!f->cut(i)->is_number())
+                      {
+                        throw std::domain_error("Piecewise functions with stored cut-off points cannot be evaluated along their dimension!");
+                      }
+                    comparison = internals::compare_numbers(value, f->cut(i));
+                    if (comparison <= 0)
+                      {
+                        break;
+                      }
+                  }
+                ret = substitute(f->piece(i), dim, value, memo);
+                if (i < f->num_cuts && comparison == 0)
+                  {
+                    ret = divide(add(ret, substitute(f->piece(i + 1), dim, value, memo)), rational(2));
+                  }
+              }
+            break;
+        }
+      memo[f] = ret;
+      return ret;
+    }
+
+    node primitive_of(node f, const indexer dim, std::unordered_map<node, node>& memo)
+    {
+      const auto found = memo.find(f);
+      if (found != memo.end())
+        {
+          return found->second;
+        }
+      node ret = nullptr;
+      if (!f->has_dimension(dim))
+        {
+          ret = multiply(f, monomial(1, dim));
+        }
+      else
+        {
+          switch (f->kind)
+            {
+              case dynamic_kind::monomial:
+                if (f->index == -1)
+                  {
+                    throw std::domain_error("The primitive of 1/x is not supported!");
+                  }
+                ret = multiply(rational(1, f->index + 1), monomial(f->index + 1, dim));
+                break;
+              case dynamic_kind::add:
+                ret = add(primitive_of(f->operands[0], dim, memo), primitive_of(f->operands[1], dim, memo));
+                break;
+              case dynamic_kind::subtract:
+                ret = subtract(primitive_of(f->operands[0], dim, memo), primitive_of(f->operands[1], dim, memo));
+                break;
+              case dynamic_kind::multiply:
+                ret = primitive_of_product(f->operands[0], f->operands[1], dim, memo);
+                break;
+              case dynamic_kind::divide:
+                if (f->operands[1]->has_dimension(dim))
+                  {
+                    throw std::domain_error("The primitive of a quotient by a function of the integration variable is not supported!");
+                  }
+                ret = divide(primitive_of(f->operands[0], dim, memo), f->operands[1]);
+                break;
+              default:
+                {
+                  std::vector<node> pieces(std::size_t(f->num_cuts) + 1);
+                  for (indexer i = 0; i <= f->num_cuts; ++i)
+                    {
+                      pieces[i] = primitive_of(f->piece(i), dim, memo);
+                    }
+                  if (f->dim == dim)
+                    {
+                      for (indexer i = 1; i <= f->num_cuts; ++i)
+                        {
+                          const node cut = f->cut(i - 1);
+                          pieces[i] = add(subtract(pieces[i], evaluate_along(pieces[i], dim, cut)), evaluate_along(pieces[i - 1], dim, cut));
+                          //So that the integration can still be performed by the difference of the primitives.
+                        }
+                    }
+                  ret = with_pieces(f, pieces);
+                  break;
+                }
+            }
+        }
+      memo[f] = ret;
+      return ret;
+    }
+
+    node primitive_of_product(node a, node b, const indexer dim, std::unordered_map<node, node>& memo)
+    {
+      if (!a->has_dimension(dim))
+        {
+          return multiply(a, primitive_of(b, dim, memo));
+        }
+      else if (!b->has_dimension(dim))
+        {
+          return multiply(primitive_of(a, dim, memo), b);
+        }
+      for (int swap = 0; swap < 2; ++swap)
+        {
+          node p = (swap ? b : a), other = (swap ? a : b);
+          if (p->kind == dynamic_kind::piecewise && p->dim == dim)
+            {
+              std::vector<node> pieces(std::size_t(p->num_cuts) + 1);
+              for (indexer i = 0; i <= p->num_cuts; ++i)
+                {
+                  pieces[i] = (swap ? multiply(other, p->piece(i)) : multiply(p->piece(i), other));
+                }
+              return primitive_of(with_pieces(p, pieces), dim, memo);
+              //Multiplying each piece is the same, even at the cut-off points (where the averages are taken).
+            }
+          if (p->has_cuts(dim) && (p->kind == dynamic_kind::add || p->kind == dynamic_kind::subtract))
+            {
+              const node first = (swap ? multiply(other, p->operands[0]) : multiply(p->operands[0], other));
+              const node second = (swap ? multiply(other, p->operands[1]) : multiply(p->operands[1], other));
+              return primitive_of(p->kind == dynamic_kind::add ? add(first, second) : subtract(first, second), dim, memo);
+            }
+        }
+      //Integration by parts, differentiating the factor with the lowest degree until it vanishes.
+      const indexer degree_a = (a->has_cuts(dim) ? -1 : polynomial_degree(a, dim));
+      const indexer degree_b = (b->has_cuts(dim) ? -1 : polynomial_degree(b, dim));
+      if (degree_a < 0 && degree_b < 0)
+        {
+          throw std::domain_error("The primitive of this product is not supported!");
+        }
+      const bool differentiate_a = (degree_b < 0 || (degree_a >= 0 && degree_a <= degree_b));
+      const node u = (differentiate_a ? a : b), v = (differentiate_a ? b : a);
+      const node prim_v = primitive_of(v, dim, memo);
+      return subtract(multiply(u, prim_v), primitive_of(multiply(derivative(u, dim), prim_v), dim, memo));
+    }
+  };
+}
+
+#endif
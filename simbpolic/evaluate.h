@@ -0,0 +1,215 @@
+#ifndef SIMBPOLIC_EVALUATE
+#define SIMBPOLIC_EVALUATE
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    template <class T>
+    inline static constexpr bool is_monomial = false;
+
+    template <class T>
+    inline static constexpr bool is_monomial<const T> = is_monomial<T>;
+
+    template <indexer order, indexer dim>
+    inline static constexpr bool is_monomial<Monomial<order, dim>> = true;
+
+    template <class T>
+    inline static constexpr indexer monomial_order = 0;
+
+    template <class T>
+    inline static constexpr indexer monomial_order<const T> = monomial_order<T>;
+
+    template <indexer order, indexer dim>
+    inline static constexpr indexer monomial_order<Monomial<order, dim>> = order;
+
+    template <class T>
+    inline static constexpr indexer monomial_dimension = 0;
+
+    template <class T>
+    inline static constexpr indexer monomial_dimension<const T> = monomial_dimension<T>;
+
+    template <indexer order, indexer dim>
+    inline static constexpr indexer monomial_dimension<Monomial<order, dim>> = dim;
+
+    enum class operation_kind
+    {
+      add, subtract, multiply, divide
+    };
+
+    /*!
+      \brief Which operation an operation function (`func_add`, `func_sub`, `func_mul` or `func_div`) performs.
+    */
+    template <class T>
+    inline static constexpr operation_kind operation_of = operation_kind::add;
+
+    template <class T>
+    inline static constexpr operation_kind operation_of<const T> = operation_of<T>;
+
+    template <class A, class B>
+    inline static constexpr operation_kind operation_of<func_sub<A, B>> = operation_kind::subtract;
+
+    template <class A, class B>
+    inline static constexpr operation_kind operation_of<func_mul<A, B>> = operation_kind::multiply;
+
+    template <class A, class B>
+    inline static constexpr operation_kind operation_of<func_div<A, B>> = operation_kind::divide;
+
+    /*!
+      \brief The value used to decide on which piece of a branched function a number lies.
+
+      \remark Number types that carry more than a value (such as the jets used for derivatives)
+              provide their own overload, which is found through argument-dependent lookup.
+    */
+    template <class Num>
+    SIMBPOLIC_CUDA_HOS_DEV SIMBPOLIC_FORCE_INLINE constexpr inline static Type value_of(const Num& x)
+    {
+      return Type(x);
+    }
+
+    template <class Num>
+    SIMBPOLIC_CUDA_HOS_DEV SIMBPOLIC_FORCE_INLINE constexpr inline static Num integer_power(const Num& x, const indexer exp)
+    {
+      return fastpow(x, exp);
+    }
+
+    template <class Cut>
+    SIMBPOLIC_CUDA_HOS_DEV SIMBPOLIC_FORCE_INLINE constexpr inline static Type resolved_value(const Cut& cut, const Type* parameters, const std::size_t stride)
+    //The numeric value of a constant (or cut-off point), looking up `Stored` ones in the parameters.
+    {
+      if constexpr (is_stored<std::decay_t<Cut>>)
+        {
+          return parameters[std::size_t(stored_count<Cut> - 1) * stride];
+        }
+      else
+        {
+          return Type(cut);
+        }
+    }
+
+    /*!
+      \brief Evaluates \p f at \p point (with `point[d - 1]` being the value of the dimension `d`)
+             using \p Num for all the arithmetic, and taking the value of `Stored<i>` from `parameters[i * stride]`.
+
+      \details Only the piece of each branched function that contains the point is evaluated,
+               and each monomial is handled by a single call to `integer_power`,
+               so number types that also carry derivatives can compute them alongside the value.
+               At the cut-off points, the average of both sides is taken, as in the usual evaluation.
+
+      \pre \p Num must be constructible from `Type` and support `+`, `-`, `*` and `/`.
+    */
+    template <class Num, class Func, std::size_t M>
+    SIMBPOLIC_CUDA_HOS_DEV SIMBPOLIC_FORCE_INLINE constexpr inline static Num evaluate_with(const Func& f, const Num (&point)[M],
+                                                                                            const Type* parameters, const std::size_t stride)
+    {
+      static_assert(Func::max_dimension <= indexer(M), "The point must have a value for every dimension of the function!");
+      if constexpr (is_exact<Func>)
+        {
+          return Num(Type(f));
+        }
+      else if constexpr (std::is_same_v<std::decay_t<Func>, Constant>)
+        {
+          return Num(f.val);
+        }
+      else if constexpr (is_stored<std::decay_t<Func>>)
+        {
+          return Num(resolved_value(f, parameters, stride));
+        }
+      else if constexpr (is_monomial<Func>)
+        {
+          return integer_power(point[monomial_dimension<Func> - 1], monomial_order<Func>);
+        }
+      else if constexpr (is_op_func<Func>)
+        {
+          const Num first = evaluate_with(f.f1(), point, parameters, stride);
+          const Num second = evaluate_with(f.f2(), point, parameters, stride);
+          switch (operation_of<Func>)
+            {
+              case operation_kind::add:
+                return first + second;
+              case operation_kind::subtract:
+                return first - second;
+              case operation_kind::multiply:
+                return first * second;
+              default:
+                return first / second;
+            }
+        }
+      else if constexpr (is_interval_function<Func>)
+        {
+          const Type x = value_of(point[branch_dimension<Func> - 1]);
+          const Type lower = resolved_value(f.lower_cut(), parameters, stride);
+          const Type upper = resolved_value(f.upper_cut(), parameters, stride);
+          if (x < lower)
+            {
+              return evaluate_with(f.f1(), point, parameters, stride);
+            }
+          else if (x == lower)
+            {
+              return (evaluate_with(f.f1(), point, parameters, stride) + evaluate_with(f.f2(), point, parameters, stride)) / Num(Type(2));
+            }
+          else if (x < upper)
+            {
+              return evaluate_with(f.f2(), point, parameters, stride);
+            }
+          else if (x == upper)
+            {
+              return (evaluate_with(f.f2(), point, parameters, stride) + evaluate_with(f.f3(), point, parameters, stride)) / Num(Type(2));
+            }
+          else
+            {
+              return evaluate_with(f.f3(), point, parameters, stride);
+            }
+        }
+      else
+        {
+          static_assert(branch_dimension<Func> != 0, "Unsupported kind of expression!");
+          const Type x = value_of(point[branch_dimension<Func> - 1]);
+          const Type cut = resolved_value(f.cut(), parameters, stride);
+          if (x < cut)
+            {
+              return evaluate_with(f.f1(), point, parameters, stride);
+            }
+          else if (x > cut)
+            {
+              return evaluate_with(f.f2(), point, parameters, stride);
+            }
+          else
+            {
+              return (evaluate_with(f.f1(), point, parameters, stride) + evaluate_with(f.f2(), point, parameters, stride)) / Num(Type(2));
+            }
+        }
+    }
+
+    /*!
+      \brief Same as above, for functions without `Stored` constants.
+    */
+    template <class Num, class Func, std::size_t M>
+    SIMBPOLIC_CUDA_HOS_DEV SIMBPOLIC_FORCE_INLINE constexpr inline static Num evaluate_with(const Func& f, const Num (&point)[M])
+    {
+      static_assert(stored_count<Func> == 0, "Stored constants need a store to be evaluated!");
+      return evaluate_with(f, point, nullptr, 0);
+    }
+  }
+
+  /*!
+    \brief Evaluates \p f at the point given by \p args, giving a plain number.
+
+    \details Unlike `f(args...)`, this never builds any symbolic object
+             (neither the `Constant` results nor the partially evaluated branched functions)
+             and only reads the subexpressions through references,
+             so, with optimizations enabled, it compiles down to the same code
+             as writing the expression by hand.
+
+    \pre There must be a value for every dimension of \p f, and \p f may not have `Stored` constants (see `bind`).
+  */
+  template <class Num = Type, class Func, class ... Args>
+  SIMBPOLIC_CUDA_HOS_DEV SIMBPOLIC_FORCE_INLINE constexpr inline static Num eval(const Func& f, const Args& ... args)
+  {
+    static_assert(sizeof...(Args) >= std::size_t(Func::max_dimension), "There must be a value for every dimension of the function!");
+    const Num point[sizeof...(Args) + 1] = {Num(args)...};
+    return internals::evaluate_with(f, point);
+  }
+}
+
+#endif
@@ -0,0 +1,377 @@
+#ifndef SIMBPOLIC_EXPRESSION_TRAITS
+#define SIMBPOLIC_EXPRESSION_TRAITS
+
+namespace Simbpolic
+{
+  /*!
+    \brief The number of nodes in the expression tree of \p T
+           (cut-off points of branched functions included).
+  */
+  template <class T>
+  inline static constexpr indexer expression_size = 1;
+
+  template <class T>
+  inline static constexpr indexer expression_size<const T> = expression_size<T>;
+
+  template <class A, class B>
+  inline static constexpr indexer expression_size<func_add<A, B>> = 1 + expression_size<A> + expression_size<B>;
+
+  template <class A, class B>
+  inline static constexpr indexer expression_size<func_sub<A, B>> = 1 + expression_size<A> + expression_size<B>;
+
+  template <class A, class B>
+  inline static constexpr indexer expression_size<func_mul<A, B>> = 1 + expression_size<A> + expression_size<B>;
+
+  template <class A, class B>
+  inline static constexpr indexer expression_size<func_div<A, B>> = 1 + expression_size<A> + expression_size<B>;
+
+  template <class A, class B, indexer dim, class Cut>
+  inline static constexpr indexer expression_size<branch_function<A, B, dim, Cut>> = 1 + expression_size<A> + expression_size<B> +
+                                                                                     expression_size<Cut>;
+
+  template <class A, class B, class C, indexer dim, class LowerCut, class UpperCut>
+  inline static constexpr indexer expression_size<interval_function<A, B, C, dim, LowerCut, UpperCut>> =
+                                    1 + expression_size<A> + expression_size<B> + expression_size<C> +
+                                    expression_size<LowerCut> + expression_size<UpperCut>;
+
+  namespace internals
+  {
+    SIMBPOLIC_CUDA_HOS_DEV inline static constexpr indexer max_of(const indexer a, const indexer b)
+    {
+      return (a > b ? a : b);
+    }
+  }
+
+  /*!
+    \brief The number of levels in the expression tree of \p T.
+  */
+  template <class T>
+  inline static constexpr indexer expression_depth = 1;
+
+  template <class T>
+  inline static constexpr indexer expression_depth<const T> = expression_depth<T>;
+
+  template <class A, class B>
+  inline static constexpr indexer expression_depth<func_add<A, B>> = 1 + internals::max_of(expression_depth<A>, expression_depth<B>);
+
+  template <class A, class B>
+  inline static constexpr indexer expression_depth<func_sub<A, B>> = 1 + internals::max_of(expression_depth<A>, expression_depth<B>);
+
+  template <class A, class B>
+  inline static constexpr indexer expression_depth<func_mul<A, B>> = 1 + internals::max_of(expression_depth<A>, expression_depth<B>);
+
+  template <class A, class B>
+  inline static constexpr indexer expression_depth<func_div<A, B>> = 1 + internals::max_of(expression_depth<A>, expression_depth<B>);
+
+  template <class A, class B, indexer dim, class Cut>
+  inline static constexpr indexer expression_depth<branch_function<A, B, dim, Cut>> = 1 + internals::max_of(expression_depth<A>, expression_depth<B>);
+
+  template <class A, class B, class C, indexer dim, class LowerCut, class UpperCut>
+  inline static constexpr indexer expression_depth<interval_function<A, B, C, dim, LowerCut, UpperCut>> =
+                                    1 + internals::max_of(expression_depth<A>, internals::max_of(expression_depth<B>, expression_depth<C>));
+
+  namespace internals
+  {
+    SIMBPOLIC_CUDA_HOS_DEV inline static constexpr indexer degree_of_sum(const indexer a, const indexer b)
+    {
+      return (a < 0 || b < 0 ? -1 : max_of(a, b));
+    }
+    
+    SIMBPOLIC_CUDA_HOS_DEV inline static constexpr indexer degree_of_product(const indexer a, const indexer b)
+    {
+      return (a < 0 || b < 0 ? -1 : a + b);
+    }
+  }
+  
+  /*!
+    \brief The highest power of the variable with index \p dim in \p T,
+           or -1 if \p T is not a (piecewise) polynomial in that variable.
+           
+    \remark For branched functions, this is the highest degree of any of the pieces.
+  */
+  template <class T, indexer dim>
+  inline static constexpr indexer polynomial_degree = 0;
+
+  template <class T, indexer dim>
+  inline static constexpr indexer polynomial_degree<const T, dim> = polynomial_degree<T, dim>;
+  
+  template <indexer order, indexer d, indexer dim>
+  inline static constexpr indexer polynomial_degree<Monomial<order, d>, dim> = (d != dim ? 0 : (order < 0 ? -1 : order));
+
+  template <class A, class B, indexer dim>
+  inline static constexpr indexer polynomial_degree<func_add<A, B>, dim> = internals::degree_of_sum(polynomial_degree<A, dim>, polynomial_degree<B, dim>);
+
+  template <class A, class B, indexer dim>
+  inline static constexpr indexer polynomial_degree<func_sub<A, B>, dim> = internals::degree_of_sum(polynomial_degree<A, dim>, polynomial_degree<B, dim>);
+
+  template <class A, class B, indexer dim>
+  inline static constexpr indexer polynomial_degree<func_mul<A, B>, dim> = internals::degree_of_product(polynomial_degree<A, dim>, polynomial_degree<B, dim>);
+
+  template <class A, class B, indexer dim>
+  inline static constexpr indexer polynomial_degree<func_div<A, B>, dim> = (polynomial_degree<B, dim> != 0 ? -1 : polynomial_degree<A, dim>);
+
+  template <class A, class B, indexer d, class Cut, indexer dim>
+  inline static constexpr indexer polynomial_degree<branch_function<A, B, d, Cut>, dim> = internals::degree_of_sum(polynomial_degree<A, dim>, polynomial_degree<B, dim>);
+
+  template <class A, class B, class C, indexer d, class LowerCut, class UpperCut, indexer dim>
+  inline static constexpr indexer polynomial_degree<interval_function<A, B, C, d, LowerCut, UpperCut>, dim> = 
+                                    internals::degree_of_sum(polynomial_degree<A, dim>, internals::degree_of_sum(polynomial_degree<B, dim>, polynomial_degree<C, dim>));
+
+  template <class T>
+  inline static constexpr bool is_interval_function = false;
+
+  template <class T>
+  inline static constexpr bool is_interval_function<const T> = is_interval_function<T>;
+
+  template <class A, class B, class C, indexer dim, class LowerCut, class UpperCut>
+  inline static constexpr bool is_interval_function<interval_function<A, B, C, dim, LowerCut, UpperCut>> = true;
+
+  /*!
+    \brief The dimension along which \p T (a `branch_function` or an `interval_function`) is branched.
+  */
+  template <class T>
+  inline static constexpr indexer branch_dimension = 0;
+
+  template <class T>
+  inline static constexpr indexer branch_dimension<const T> = branch_dimension<T>;
+
+  template <class A, class B, indexer dim, class Cut>
+  inline static constexpr indexer branch_dimension<branch_function<A, B, dim, Cut>> = dim;
+
+  template <class A, class B, class C, indexer dim, class LowerCut, class UpperCut>
+  inline static constexpr indexer branch_dimension<interval_function<A, B, C, dim, LowerCut, UpperCut>> = dim;
+
+  /*!
+    \brief The number of cut-off points along \p dim in all the branched functions of \p T.
+  */
+  template <class T, indexer dim>
+  inline static constexpr indexer cut_count = 0;
+
+  template <class T, indexer dim>
+  inline static constexpr indexer cut_count<const T, dim> = cut_count<T, dim>;
+
+  template <class A, class B, indexer dim>
+  inline static constexpr indexer cut_count<func_add<A, B>, dim> = cut_count<A, dim> + cut_count<B, dim>;
+
+  template <class A, class B, indexer dim>
+  inline static constexpr indexer cut_count<func_sub<A, B>, dim> = cut_count<A, dim> + cut_count<B, dim>;
+
+  template <class A, class B, indexer dim>
+  inline static constexpr indexer cut_count<func_mul<A, B>, dim> = cut_count<A, dim> + cut_count<B, dim>;
+
+  template <class A, class B, indexer dim>
+  inline static constexpr indexer cut_count<func_div<A, B>, dim> = cut_count<A, dim> + cut_count<B, dim>;
+
+  template <class A, class B, indexer d, class Cut, indexer dim>
+  inline static constexpr indexer cut_count<branch_function<A, B, d, Cut>, dim> = (d == dim) + cut_count<A, dim> + cut_count<B, dim>;
+
+  template <class A, class B, class C, indexer d, class LowerCut, class UpperCut, indexer dim>
+  inline static constexpr indexer cut_count<interval_function<A, B, C, d, LowerCut, UpperCut>, dim> =
+                                    2 * (d == dim) + cut_count<A, dim> + cut_count<B, dim> + cut_count<C, dim>;
+
+  /*!
+    \brief One more than the highest index of the `Stored` constants in \p T
+           (cut-off points included), or 0 if there are none.
+  */
+  template <class T>
+  inline static constexpr indexer stored_count = 0;
+
+  template <class T>
+  inline static constexpr indexer stored_count<const T> = stored_count<T>;
+
+  template <indexer idx>
+  inline static constexpr indexer stored_count<Stored<idx>> = idx + 1;
+
+  template <class A, class B>
+  inline static constexpr indexer stored_count<func_add<A, B>> = internals::max_of(stored_count<A>, stored_count<B>);
+
+  template <class A, class B>
+  inline static constexpr indexer stored_count<func_sub<A, B>> = internals::max_of(stored_count<A>, stored_count<B>);
+
+  template <class A, class B>
+  inline static constexpr indexer stored_count<func_mul<A, B>> = internals::max_of(stored_count<A>, stored_count<B>);
+
+  template <class A, class B>
+  inline static constexpr indexer stored_count<func_div<A, B>> = internals::max_of(stored_count<A>, stored_count<B>);
+
+  template <class A, class B, indexer dim, class Cut>
+  inline static constexpr indexer stored_count<branch_function<A, B, dim, Cut>> =
+                                    internals::max_of(internals::max_of(stored_count<A>, stored_count<B>), stored_count<Cut>);
+
+  template <class A, class B, class C, indexer dim, class LowerCut, class UpperCut>
+  inline static constexpr indexer stored_count<interval_function<A, B, C, dim, LowerCut, UpperCut>> =
+                                    internals::max_of(internals::max_of(stored_count<A>, internals::max_of(stored_count<B>, stored_count<C>)),
+                                                      internals::max_of(stored_count<LowerCut>, stored_count<UpperCut>));
+
+  namespace internals
+  {
+    /*!
+      \brief A rational number whose value is only known at run-time
+             (or while evaluating a constant expression), always kept in lowest terms
+             and with a positive denominator.
+    */
+    struct exact_fraction
+    {
+      long long num = 0, den = 1;
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr exact_fraction()
+      {
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr exact_fraction(const long long n, const long long d = 1): num(n), den(d)
+      {
+        const long long divisor = std::gcd(num, den);
+        if (divisor != 0)
+          {
+            num /= divisor;
+            den /= divisor;
+          }
+        if (den < 0)
+          {
+            num = -num;
+            den = -den;
+          }
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr bool is_zero() const
+      {
+        return num == 0;
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr exact_fraction operator- () const
+      {
+        return exact_fraction(-num, den);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr exact_fraction operator+ (const exact_fraction& a, const exact_fraction& b)
+      {
+        return exact_fraction(a.num * b.den + b.num * a.den, a.den * b.den);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr exact_fraction operator- (const exact_fraction& a, const exact_fraction& b)
+      {
+        return exact_fraction(a.num * b.den - b.num * a.den, a.den * b.den);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr exact_fraction operator* (const exact_fraction& a, const exact_fraction& b)
+      {
+        return exact_fraction(a.num * b.num, a.den * b.den);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr exact_fraction operator/ (const exact_fraction& a, const exact_fraction& b)
+      {
+        return exact_fraction(a.num * b.den, a.den * b.num);
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr bool operator< (const exact_fraction& a, const exact_fraction& b)
+      {
+        return a.num * b.den < b.num * a.den;
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV friend constexpr bool operator== (const exact_fraction& a, const exact_fraction& b)
+      {
+        return a.num == b.num && a.den == b.den;
+      }
+    };
+
+    template <class T>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static exact_fraction exact_value_of(const T& x)
+    {
+      static_assert(is_exact<T>, "Only exact numbers have an exact value!");
+      if constexpr (std::is_same_v<std::decay_t<T>, Zero>)
+        {
+          return exact_fraction(0);
+        }
+      else if constexpr (std::is_same_v<std::decay_t<T>, One>)
+        {
+          return exact_fraction(1);
+        }
+      else
+        {
+          return exact_fraction(std::decay_t<T>::num, std::decay_t<T>::denom);
+        }
+    }
+  }
+
+  /*!
+    \brief Whether \p T is an exact number or an arithmetic expression (`func_add`, `func_sub`, `func_mul` or `func_div`)
+           of exact numbers only, which `reduce_exact` collapses into a single exact number.
+  */
+  template <class T>
+  inline static constexpr bool is_exact_expression = is_exact<T>;
+
+  template <class T>
+  inline static constexpr bool is_exact_expression<const T> = is_exact_expression<T>;
+
+  template <class A, class B>
+  inline static constexpr bool is_exact_expression<func_add<A, B>> = is_exact_expression<A> && is_exact_expression<B>;
+
+  template <class A, class B>
+  inline static constexpr bool is_exact_expression<func_sub<A, B>> = is_exact_expression<A> && is_exact_expression<B>;
+
+  template <class A, class B>
+  inline static constexpr bool is_exact_expression<func_mul<A, B>> = is_exact_expression<A> && is_exact_expression<B>;
+
+  template <class A, class B>
+  inline static constexpr bool is_exact_expression<func_div<A, B>> = is_exact_expression<A> && is_exact_expression<B>;
+
+  /*!
+    \brief Whether every coefficient and cut-off point of \p T is exact
+            (that is, \p T is built only from exact numbers and monomials, without `Constant`s or `Stored` constants).
+  */
+  template <class T>
+  inline static constexpr bool has_exact_coefficients = is_exact<T>;
+
+  template <class T>
+  inline static constexpr bool has_exact_coefficients<const T> = has_exact_coefficients<T>;
+
+  template <indexer order, indexer dim>
+  inline static constexpr bool has_exact_coefficients<Monomial<order, dim>> = true;
+
+  template <class A, class B>
+  inline static constexpr bool has_exact_coefficients<func_add<A, B>> = has_exact_coefficients<A> && has_exact_coefficients<B>;
+
+  template <class A, class B>
+  inline static constexpr bool has_exact_coefficients<func_sub<A, B>> = has_exact_coefficients<A> && has_exact_coefficients<B>;
+
+  template <class A, class B>
+  inline static constexpr bool has_exact_coefficients<func_mul<A, B>> = has_exact_coefficients<A> && has_exact_coefficients<B>;
+
+  template <class A, class B>
+  inline static constexpr bool has_exact_coefficients<func_div<A, B>> = has_exact_coefficients<A> && has_exact_coefficients<B>;
+
+  template <class A, class B, indexer dim, class Cut>
+  inline static constexpr bool has_exact_coefficients<branch_function<A, B, dim, Cut>> =
+                                 has_exact_coefficients<A> && has_exact_coefficients<B> && is_exact<Cut>;
+
+  template <class A, class B, class C, indexer dim, class LowerCut, class UpperCut>
+  inline static constexpr bool has_exact_coefficients<interval_function<A, B, C, dim, LowerCut, UpperCut>> =
+                                 has_exact_coefficients<A> && has_exact_coefficients<B> && has_exact_coefficients<C> &&
+                                 is_exact<LowerCut> && is_exact<UpperCut>;
+
+  namespace internals
+  {
+    /*!
+      \brief The value of an exact expression (see `is_exact_expression`), computed at compile-time.
+    */
+    template <class T>
+    inline static constexpr exact_fraction exact_expression_value = exact_value_of(std::decay_t<T>{});
+
+    template <class T>
+    inline static constexpr exact_fraction exact_expression_value<const T> = exact_expression_value<T>;
+
+    template <class A, class B>
+    inline static constexpr exact_fraction exact_expression_value<func_add<A, B>> = exact_expression_value<A> + exact_expression_value<B>;
+
+    template <class A, class B>
+    inline static constexpr exact_fraction exact_expression_value<func_sub<A, B>> = exact_expression_value<A> - exact_expression_value<B>;
+
+    template <class A, class B>
+    inline static constexpr exact_fraction exact_expression_value<func_mul<A, B>> = exact_expression_value<A> * exact_expression_value<B>;
+
+    template <class A, class B>
+    inline static constexpr exact_fraction exact_expression_value<func_div<A, B>> = exact_expression_value<A> / exact_expression_value<B>;
+  }
+}
+
+#endif
@@ -81,7 +81,7 @@ namespace Simbpolic
       }
       
       template <indexer i>
-      SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto get() const
+      SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) get() const
       {
           return holder_helper<member, 1, holds_values<member>, true>::get();
       }
@@ -103,7 +103,7 @@ namespace Simbpolic
       }
       
       template <indexer i>
-      SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto get() const
+      SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) get() const
       {
         if constexpr (i == sizeof...(members) + 1)
           {
@@ -125,7 +125,7 @@ namespace Simbpolic
     using internals::holder_impl<funcs...>::holder_impl;
       
     template <indexer i>
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto get() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) get() const
     {
       return internals::holder_impl<funcs...>::template get<sizeof...(funcs) - i>();
     }
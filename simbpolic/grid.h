@@ -0,0 +1,178 @@
+#ifndef SIMBPOLIC_GRID
+#define SIMBPOLIC_GRID
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    template <std::size_t count, std::size_t stride, std::size_t l = 0>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Type contract(const Type* coeffs, const Type* powers)
+    //The sum of `coeffs[l * stride] * powers[l]` for `l` from 0 to `count - 1` (unrolled at compile-time).
+    {
+      if constexpr (l + 1 == count)
+        {
+          return coeffs[l * stride] * powers[l];
+        }
+      else
+        {
+          return coeffs[l * stride] * powers[l] + contract<count, stride, l + 1>(coeffs, powers);
+        }
+    }
+
+    /*!
+      \brief The per-axis data used by `evaluate_grid`: for each coordinate, the index of the piece
+             (between the sorted cut-off points along \p dim) that contains it, or -1 if it lies exactly at a cut-off point,
+             and the powers of its distance to the anchor of that piece, up to the degree of \p Func along \p dim.
+
+      \remark The anchor of each piece is the first coordinate that falls inside it,
+              so the powers stay small for the coordinates that are actually used.
+    */
+    template <class Func, indexer dim>
+    struct grid_axis
+    {
+      static constexpr indexer degree = (dim <= Func::max_dimension ? polynomial_degree<Func, dim> : 0);
+      static constexpr indexer max_pieces = cut_count<Func, dim> + 1;
+
+      std::vector<indexer> pieces;
+      std::vector<Type> powers;
+      Type anchors[max_pieces] {};
+      bool used[max_pieces] {};
+
+      grid_axis(const Func& f, const Type* coords, const std::size_t n): pieces(n), powers(n * std::size_t(degree + 1))
+      {
+        Type cuts[max_pieces] {};
+        const indexer num_cuts = sorted_cuts<dim>(f, cuts);
+        for (std::size_t i = 0; i < n; ++i)
+          {
+            indexer piece = 0;
+            while (piece < num_cuts && cuts[piece] < coords[i])
+              {
+                ++piece;
+              }
+            if (piece < num_cuts && cuts[piece] == coords[i])
+              {
+                pieces[i] = -1;
+                continue;
+              }
+            if (!used[piece])
+              {
+                used[piece] = true;
+                anchors[piece] = coords[i];
+              }
+            pieces[i] = piece;
+            const Type t = coords[i] - anchors[piece];
+            Type power(1);
+            for (indexer e = 0; e <= degree; ++e)
+              {
+                powers[i * std::size_t(degree + 1) + std::size_t(e)] = power;
+                power = power * t;
+              }
+          }
+      }
+
+      const Type* powers_of(const std::size_t i) const
+      {
+        return powers.data() + i * std::size_t(degree + 1);
+      }
+    };
+  }
+
+  /*!
+    \brief Writes the value of \p f at every point `(xs[i], ys[j], zs[k])` of a rectilinear grid
+           to `out[i + nx * (j + ny * k)]` (that is, with the first dimension varying fastest, as in `project_cells`).
+
+    \details Since the piece of a branched function is chosen by a single coordinate,
+             \p f is a single polynomial inside each cell of the product of the cut-off points along the three axes.
+             That polynomial is expanded once per cell (by evaluating \p f with polynomials instead of numbers),
+             each axis gets a table of powers and piece indices, and the grid is then filled by contracting
+             the coefficients with the tables one axis at a time, so most of the work is multiply-adds over table entries.
+             Points with a coordinate exactly at a cut-off point are evaluated directly
+             (giving the average of both sides, as usual).
+
+    \pre \p f may only depend on the first three dimensions, must be a polynomial along them (in each of its pieces)
+         and may not have `Stored` constants.
+  */
+  template <class Func>
+  inline static void evaluate_grid(const Func& f, const Type* xs, const std::size_t nx, const Type* ys, const std::size_t ny,
+                                   const Type* zs, const std::size_t nz, Type* out)
+  {
+    static_assert(Func::max_dimension <= 3, "The function may only depend on the dimensions of the grid!");
+    static_assert(stored_count<Func> == 0, "Stored constants need a store to be evaluated!");
+
+    using x_axis = internals::grid_axis<Func, 1>;
+    using y_axis = internals::grid_axis<Func, 2>;
+    using z_axis = internals::grid_axis<Func, 3>;
+
+    static_assert(x_axis::degree >= 0 && y_axis::degree >= 0 && z_axis::degree >= 0,
+                  "The function must be a polynomial along the dimensions of the grid!");
+
+    constexpr std::size_t dx = std::size_t(x_axis::degree) + 1, dy = std::size_t(y_axis::degree) + 1, dz = std::size_t(z_axis::degree) + 1;
+    constexpr std::size_t px = std::size_t(x_axis::max_pieces), py = std::size_t(y_axis::max_pieces), pz = std::size_t(z_axis::max_pieces);
+
+    using poly_type = dense_polynomial<3, x_axis::degree, y_axis::degree, z_axis::degree>;
+
+    const x_axis X(f, xs, nx);
+    const y_axis Y(f, ys, ny);
+    const z_axis Z(f, zs, nz);
+
+    std::vector<poly_type> cells(px * py * pz);
+    for (std::size_t c = 0; c < cells.size(); ++c)
+      {
+        const std::size_t a = c % px, b = (c / px) % py, e = c / (px * py);
+        if (X.used[a] && Y.used[b] && Z.used[e])
+          {
+            poly_type point[3] {poly_type::variable(0), poly_type::variable(1), poly_type::variable(2)};
+            point[0].coefficients[0] = X.anchors[a];
+            point[1].coefficients[0] = Y.anchors[b];
+            point[2].coefficients[0] = Z.anchors[e];
+            //The anchors pick the pieces of the cell, and the result is expanded around them.
+            cells[c] = internals::evaluate_with(f, point);
+          }
+      }
+
+    std::vector<Type> along_z(px * py * dx * dy), along_y(px * dx);
+    //along_z[(a + px * b) * dx * dy + ...] holds the coefficients contracted with the powers of the current z,
+    //and along_y[a * dx + ...] those also contracted with the powers of the current y.
+
+    for (std::size_t k = 0; k < nz; ++k)
+      {
+        const indexer e = Z.pieces[k];
+        for (std::size_t c = 0; c < px * py && e >= 0; ++c)
+          {
+            const poly_type& cell = cells[c + px * py * std::size_t(e)];
+            const Type* zp = Z.powers_of(k);
+            for (std::size_t m = 0; m < dx * dy; ++m)
+              {
+                along_z[c * dx * dy + m] = internals::contract<dz, dx * dy>(cell.coefficients + m, zp);
+              }
+          }
+        for (std::size_t j = 0; j < ny; ++j)
+          {
+            const indexer b = Y.pieces[j];
+            for (std::size_t a = 0; a < px && e >= 0 && b >= 0; ++a)
+              {
+                const Type* yp = Y.powers_of(j);
+                const Type* coeffs = along_z.data() + (a + px * std::size_t(b)) * dx * dy;
+                for (std::size_t m = 0; m < dx; ++m)
+                  {
+                    along_y[a * dx + m] = internals::contract<dy, dx>(coeffs + m, yp);
+                  }
+              }
+            Type* row = out + nx * (j + ny * k);
+            for (std::size_t i = 0; i < nx; ++i)
+              {
+                const indexer a = X.pieces[i];
+                if (a < 0 || b < 0 || e < 0)
+                  {
+                    const Type point[3] = {xs[i], ys[j], zs[k]};
+                    row[i] = internals::evaluate_with(f, point);
+                    continue;
+                  }
+                row[i] = internals::contract<dx, 1>(along_y.data() + std::size_t(a) * dx, X.powers_of(i));
+              }
+          }
+      }
+  }
+}
+
+#endif
@@ -4,30 +4,98 @@
 namespace Simbpolic
 {
 
-  template <class Func, indexer dim, class StartT, class EndT>
-  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto integrate(const Func& f, const Var<dim> &var, const StartT &start, const EndT &end)
+  /*!
+    \brief Collapses \p f into a single exact number (`Zero`, `One` or a `Rational` in lowest terms)
+           if it is an arithmetic expression of exact numbers only (see `is_exact_expression`),
+           or gives it back unchanged otherwise.
+
+    \details The value is computed at compile-time from the whole expression at once,
+             so it does not depend on which overloads of the operators the expression went through.
+  */
+  template <class Func>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto reduce_exact(const Func& f)
   {
-    if constexpr (Func::template has_dimension<dim>())
+    if constexpr (is_exact_expression<Func>)
       {
-        //const auto dist = distribute<7>(f);
-        //OPTIMIZATION TO DO: Adjust this better.
-        
-        const auto prim = f.template primitive<dim>();
-        const auto eval_end = prim.template evaluate_along_dim<dim>(end);
-        const auto eval_start = prim.template evaluate_along_dim<dim>(start);
-        const auto ret = eval_end - eval_start;
-        return ret;
-        //Evaluates along a dimension,
-        //keeping all others as variables
+        constexpr internals::exact_fraction value = internals::exact_expression_value<Func>;
+        static_assert(value.den != 0, "Division by zero!");
+        static_assert(value.num >= std::numeric_limits<indexer>::min() && value.num <= std::numeric_limits<indexer>::max() &&
+                      value.den <= std::numeric_limits<indexer>::max(), "The exact value does not fit in a Rational!");
+        return Rational<indexer(value.num), indexer(value.den)>::simplify();
       }
     else
       {
-        const auto diff = end - start;
-        const auto ret = f * diff;
-        return ret;
+        return f;
       }
   }
-  
+
+  template <class Func, indexer dim, class StartT, class EndT>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto integrate(const Func& f, const Var<dim> &var, const StartT &start, const EndT &end);
+
+  namespace internals
+  {
+    /*!
+      \remark Sums are integrated term by term and products are split
+               into the factors that depend on \p dim and the ones that don't
+               (see `is_separable_along`), so that only the former go through `primitive`.
+               Otherwise, the integrand is distributed (see `distribute_fully`)
+               if that lowers its `integral_complexity`.
+    */
+    template <class Func, indexer dim, class StartT, class EndT>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto integrate_along(const Func& f, const Var<dim> &var, const StartT &start, const EndT &end)
+    {
+      if constexpr (Func::template has_dimension<dim>() && is_sum<Func>)
+        {
+          return Func::substitute(integrate(f.f1(), var, start, end), integrate(f.f2(), var, start, end));
+        }
+      else if constexpr (is_separable_along<Func, dim>)
+        {
+          const auto factors = internals::split_along_dim<dim>(f);
+          const auto integrand = integrate(factors.template get<0>(), var, start, end);
+          return integrand * factors.template get<1>();
+        }
+      else if constexpr (Func::template has_dimension<dim>() &&
+                         decltype(distribute_fully(f))::template integral_complexity<dim>() <
+                         Func::template integral_complexity<dim>()                                )
+        {
+          return integrate(distribute_fully(f), var, start, end);
+        }
+      else if constexpr (Func::template has_dimension<dim>())
+        {
+          const auto prim = f.template primitive<dim>();
+          const auto eval_end = prim.template evaluate_along_dim<dim>(end);
+          const auto eval_start = prim.template evaluate_along_dim<dim>(start);
+          const auto ret = eval_end - eval_start;
+          return ret;
+          //Evaluates along a dimension,
+          //keeping all others as variables
+        }
+      else
+        {
+          const auto diff = end - start;
+          const auto ret = f * diff;
+          return ret;
+        }
+    }
+  }
+
+  /*!
+    \brief Integrates \p f along \p dim from \p start to \p end.
+
+    \details The result is passed through `reduce_exact`, so an integral that only involves exact coefficients,
+             cut-off points and limits, and does not depend on any other dimension, is always a single exact number,
+             with no cost at run-time (which is checked at compile-time).
+  */
+  template <class Func, indexer dim, class StartT, class EndT>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto integrate(const Func& f, const Var<dim> &var, const StartT &start, const EndT &end)
+  {
+    const auto ret = reduce_exact(internals::integrate_along(f, var, start, end));
+    using result_type = std::decay_t<decltype(ret)>;
+    static_assert(!(has_exact_coefficients<Func> && is_exact<StartT> && is_exact<EndT> && result_type::max_dimension == 0) ||
+                  is_exact<result_type>, "Exact integrals should reduce to a single exact number!");
+    return ret;
+  }
+
   /*!
     \remark integrate(f, x, a(y), b(y), y, c(z), d(z)) will do \int_{c(z)}^{d(z)} \int_{a(y)}^{b(y)} f(x, y) dx dy
   */
@@ -14,27 +14,27 @@ namespace Simbpolic
     
     using func_holder<A, B, C, LowerCut, UpperCut>::func_holder;
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f1() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f1() const
     {
       return func_holder<A, B, C, LowerCut, UpperCut>::template get<0>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f2() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f2() const
     {
       return func_holder<A, B, C, LowerCut, UpperCut>::template get<1>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f3() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f3() const
     {
       return func_holder<A, B, C, LowerCut, UpperCut>::template get<2>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto lower_cut() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) lower_cut() const
     {
       return func_holder<A, B, C, LowerCut, UpperCut>::template get<3>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto upper_cut() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) upper_cut() const
     {
       return func_holder<A, B, C, LowerCut, UpperCut>::template get<4>();
     }
@@ -113,6 +113,15 @@ namespace Simbpolic
         {
           return A{} * Monomial<1, dimension>{};
         }
+      else if constexpr (has_dimension<dimension>() && dimension != dim)
+        {
+          const auto prim_1 = f1().template primitive<dimension>();
+          const auto prim_2 = f2().template primitive<dimension>();
+          const auto prim_3 = f3().template primitive<dimension>();
+          return interval_function<decltype(prim_1), decltype(prim_2), decltype(prim_3), dim, LowerCut, UpperCut>
+                          {prim_1, prim_2, prim_3, lower_cut(), upper_cut()};
+          //The pieces do not meet along dimension, so no integration constants are needed.
+        }
       else if constexpr (has_dimension<dimension>())
         {
           const auto prim_1 = f1().template primitive<dimension>();
@@ -362,7 +371,7 @@ namespace Simbpolic
         {
           const auto result1 = f1()(first, args...);
           const auto result2 = f2()(first, args...);
-          const auto result3 = f3()(args...);
+          const auto result3 = f3()(first, args...);
           const auto ret = interval_function<decltype(result1), decltype(result2), decltype(result3), dim, LowerCut, UpperCut>{result1, result2, result3, lower_cut(), upper_cut()};
           
           return ret.template decide<1>(first, args...);
@@ -0,0 +1,145 @@
+#ifndef SIMBPOLIC_MOMENTS
+#define SIMBPOLIC_MOMENTS
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    template <indexer dim, indexer n, class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto repeated_primitive(const Func& f)
+    {
+      if constexpr (n == 0)
+        {
+          return f;
+        }
+      else
+        {
+          return repeated_primitive<dim, n - 1>(f.template primitive<dim>());
+        }
+    }
+
+    template <indexer n, class T>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto exact_power(const T& x)
+    {
+      if constexpr (n == 0)
+        {
+          return One{};
+        }
+      else
+        {
+          return exact_power<n - 1>(x) * x;
+        }
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static indexer falling_factorial(const indexer k, const indexer j)
+    //k * (k - 1) * ... * (k - j + 1)
+    {
+      indexer ret = 1;
+      for (indexer i = 0; i < j; ++i)
+        {
+          ret *= k - i;
+        }
+      return ret;
+    }
+
+    /*!
+      \brief The `j`-th term of the expansion of the `k`-th moment,
+             `(-1)^j k!/(k-j)! [x^(k-j) F_(j+1)(x)]` between \p a and \p b,
+             with all the arithmetic being done symbolically.
+    */
+    template <indexer dim, indexer k, indexer j, class Func, class StartT, class EndT>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto exact_moment_term(const Func& f, const StartT& a, const EndT& b)
+    {
+      const auto prim = repeated_primitive<dim, j + 1>(f);
+      const auto difference = exact_power<k - j>(b) * prim.template evaluate_along_dim<dim>(b) -
+                              exact_power<k - j>(a) * prim.template evaluate_along_dim<dim>(a);
+      return Rational<(j % 2 ? -1 : 1) * falling_factorial(k, j), 1>{} * difference;
+    }
+
+    template <indexer dim, indexer k, class Func, class StartT, class EndT, indexer ... js>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Type exact_moment(const Func& f, const StartT& a, const EndT& b,
+                                                                     std::integer_sequence<indexer, js...>)
+    {
+      return Type((Zero{} + ... + exact_moment_term<dim, k, js>(f, a, b)));
+    }
+
+    template <indexer dim, indexer K, class Func, class StartT, class EndT, indexer ... ks>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static std::array<Type, K + 1> exact_moments(const Func& f, const StartT& a, const EndT& b,
+                                                                                         std::integer_sequence<indexer, ks...>)
+    {
+      return {exact_moment<dim, ks>(f, a, b, std::make_integer_sequence<indexer, ks + 1>{})...};
+    }
+
+    /*!
+      \brief Stores the values of the successive primitives of \p prim (starting with itself)
+             at \p a and \p b in the positions \p j to \p K of \p at_start and \p at_end.
+    */
+    template <indexer dim, indexer j, indexer K, class Prim>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void primitive_values(const Prim& prim, const Type& a, const Type& b,
+                                                                         Type (&at_start)[K + 1], Type (&at_end)[K + 1])
+    {
+      at_start[j] = Type(prim.template evaluate_along_dim<dim>(a));
+      at_end[j] = Type(prim.template evaluate_along_dim<dim>(b));
+      if constexpr (j < K)
+        {
+          primitive_values<dim, j + 1, K>(prim.template primitive<dim>(), a, b, at_start, at_end);
+        }
+    }
+  }
+
+  /*!
+    \brief Gives the moments `\int_a^b x^k f(x) dx` along \p dim, for `k` from 0 to \p K.
+
+    \remark Repeated integration by parts gives, with `F_j` the `j`-th primitive of \p f,
+            `\int_a^b x^k f(x) dx = \sum_{j = 0}^{k} (-1)^j k!/(k-j)! [x^(k-j) F_(j+1)(x)]_a^b`,
+            so only the first `K + 1` primitives of \p f are ever needed, for all the moments
+            (and, with numeric limits, they are only evaluated once at each limit).
+            Since the primitives of branched functions are continuous across the cut-off points,
+            this also holds for piecewise functions.
+
+    \remark If \p f and the limits are exact, every moment is computed as an exact `Rational`
+            before being converted, so the result is the correctly rounded value
+            (and it can be used in constant expressions).
+
+    \pre \p f may only depend on \p dim.
+  */
+  template <indexer K, class Func, indexer dim, class StartT, class EndT>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static std::array<Type, K + 1> moments(const Func& f, const Var<dim> &var,
+                                                                                 const StartT &start, const EndT &end)
+  {
+    static_assert(K >= 0, "The number of moments cannot be negative!");
+    static_assert(internals::integrates_all_dimensions<Func, 1, Var<dim>>(), "The function may only depend on the integration variable!");
+    static_assert(is_numeric<StartT> && is_numeric<EndT>, "The limits of integration must be numbers!");
+
+    if constexpr (is_exact<StartT> && is_exact<EndT> &&
+                  is_exact<decltype(internals::repeated_primitive<dim, K + 1>(f).template evaluate_along_dim<dim>(start))> &&
+                  is_exact<decltype(f.template evaluate_along_dim<dim>(start))>)
+      {
+        return internals::exact_moments<dim, K>(f, start, end, std::make_integer_sequence<indexer, K + 1>{});
+      }
+    else
+      {
+        const Type a(start), b(end);
+        Type at_start[K + 1] {}, at_end[K + 1] {};
+        internals::primitive_values<dim, 0, K>(f.template primitive<dim>(), a, b, at_start, at_end);
+
+        std::array<Type, K + 1> ret {};
+        for (indexer k = 0; k <= K; ++k)
+          {
+            Type sum(0), power_a(1), power_b(1);
+            for (indexer j = k; j >= 0; --j)
+              //From the highest j, so that the powers of the limits can be built up as we go.
+              {
+                const Type coefficient(Type((j % 2 ? -1 : 1) * internals::falling_factorial(k, j)));
+                sum = sum + coefficient * (power_b * at_end[j] - power_a * at_start[j]);
+                power_a = power_a * a;
+                power_b = power_b * b;
+              }
+            ret[k] = sum;
+          }
+        return ret;
+      }
+  }
+}
+
+#endif
@@ -74,7 +74,7 @@ namespace Simbpolic
             }          
           else
             {*/
-              return Rational<1, order+1>{} * Monomial<order+1, dim>{};
+              return Rational<(order + 1 < 0 ? -1 : 1), (order + 1 < 0 ? -(order + 1) : order + 1)>{} * Monomial<order+1, dim>{};
             /*}*/
         }
       else
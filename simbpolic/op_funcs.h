@@ -12,12 +12,12 @@ namespace Simbpolic
     
     using func_holder<A, B>::func_holder;
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f1() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f1() const
     {
       return func_holder<A,B>::template get<0>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f2() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f2() const
     {
       return func_holder<A,B>::template get<1>();
     }
@@ -131,12 +131,12 @@ namespace Simbpolic
     
     using func_holder<A, B>::func_holder;
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f1() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f1() const
     {
       return func_holder<A,B>::template get<0>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f2() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f2() const
     {
       return func_holder<A,B>::template get<1>();
     }
@@ -249,12 +249,12 @@ namespace Simbpolic
     
     using func_holder<A, B>::func_holder;
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f1() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f1() const
     {
       return func_holder<A,B>::template get<0>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f2() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f2() const
     {
       return func_holder<A,B>::template get<1>();
     }
@@ -479,12 +479,12 @@ namespace Simbpolic
     
     using func_holder<A, B>::func_holder;
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f1() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f1() const
     {
       return func_holder<A,B>::template get<0>();
     }
     
-    SIMBPOLIC_CUDA_HOS_DEV inline constexpr auto f2() const
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr decltype(auto) f2() const
     {
       return func_holder<A,B>::template get<1>();
     }
@@ -539,7 +539,7 @@ namespace Simbpolic
     template <indexer dim>
     SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto derivative() const
     {
-      return (f1().template derivative<dim>()) / f2() + f1() * (f2().template derivative<dim>())/(f2() * f2());
+      return (f1().template derivative<dim>()) / f2() - f1() * (f2().template derivative<dim>())/(f2() * f2());
     }
     
     template <indexer dim, class ... Args>
@@ -0,0 +1,126 @@
+#ifndef SIMBPOLIC_PARAMETERS
+#define SIMBPOLIC_PARAMETERS
+
+namespace Simbpolic
+{
+  /*!
+    \brief A store holding the values of `Stored<0>` to `Stored<N - 1>` contiguously.
+  */
+  template <indexer N>
+  struct ParameterStore : public Store
+  {
+    static_assert(N > 0, "A parameter store must hold at least one value!");
+
+    Type values[N] {};
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr ParameterStore()
+    {
+    }
+
+    template <class ... Args, typename std::enable_if_t<sizeof...(Args) == std::size_t(N)>* = nullptr>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr ParameterStore(const Args& ... args): values{Type(args)...}
+    {
+    }
+
+    template <indexer i>
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr Type get() const
+    {
+      static_assert(i >= 0 && i < N, "Constant index out of the range of the store!");
+      return values[i];
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr Type& operator[] (const indexer i)
+    {
+      return values[i];
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV inline constexpr const Type& operator[] (const indexer i) const
+    {
+      return values[i];
+    }
+  };
+
+  namespace internals
+  {
+    template <class Func, class A, class B>
+    struct with_operands;
+
+    template <template <class, class> class Op, class OldA, class OldB, class A, class B>
+    struct with_operands<Op<OldA, OldB>, A, B>
+    {
+      using type = Op<A, B>;
+    };
+
+    template <class Func, class A, class B>
+    using with_operands_t = typename with_operands<std::decay_t<Func>, A, B>::type;
+  }
+
+  /*!
+    \brief Gives \p f with every `Stored<i>` (including those in cut-off points)
+           replaced by a `Constant` with the value taken from \p store.
+
+    \remark The structure of the expression is otherwise kept as is,
+            so evaluating the result does not need to look anything up in the store
+            or rebuild any part of the expression.
+  */
+  template <class Func, class StoreT>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto bind(const Func& f, const StoreT& store)
+  {
+    static_assert(is_store<StoreT>, "The constants must be given through a store!");
+    if constexpr (stored_count<Func> == 0)
+      {
+        return f;
+      }
+    else if constexpr (is_stored<std::decay_t<Func>>)
+      {
+        return Constant{Type(store.template get<stored_count<Func> - 1>())};
+      }
+    else if constexpr (is_op_func<Func>)
+      {
+        const auto first = bind(f.f1(), store);
+        const auto second = bind(f.f2(), store);
+        return internals::with_operands_t<Func, decltype(first), decltype(second)>{first, second};
+      }
+    else if constexpr (is_interval_function<Func>)
+      {
+        const auto g_1 = bind(f.f1(), store);
+        const auto g_2 = bind(f.f2(), store);
+        const auto g_3 = bind(f.f3(), store);
+        const auto lower = bind(f.lower_cut(), store);
+        const auto upper = bind(f.upper_cut(), store);
+        return interval_function<decltype(g_1), decltype(g_2), decltype(g_3), branch_dimension<Func>, decltype(lower), decltype(upper)>
+                  {g_1, g_2, g_3, lower, upper};
+      }
+    else
+      {
+        const auto g_1 = bind(f.f1(), store);
+        const auto g_2 = bind(f.f2(), store);
+        const auto cut = bind(f.cut(), store);
+        return branch_function<decltype(g_1), decltype(g_2), branch_dimension<Func>, decltype(cut)>{g_1, g_2, cut};
+      }
+  }
+
+  /*!
+    \brief Evaluates \p f at the point given by \p args for each of \p num_sets sets of constants,
+           writing the result for the set `s` to `results[s]`.
+
+    \details The constants are laid out as a structure of arrays:
+             the value of `Stored<i>` in the set `s` is `parameters[i * num_sets + s]`.
+
+    \remark The point is only converted once and the expression is not rebuilt for each set,
+            so this is just a loop over the sets evaluating \p f directly.
+  */
+  template <class Func, class ... Args>
+  SIMBPOLIC_CUDA_HOS_DEV inline static void evaluate_sweep(const Func& f, const Type* parameters, const std::size_t num_sets,
+                                                           Type* results, const Args& ... args)
+  {
+    static_assert(sizeof...(Args) >= std::size_t(Func::max_dimension), "There must be a value for every dimension of the function!");
+    const Type point[sizeof...(Args) + 1] = {Type(args)...};
+    for (std::size_t s = 0; s < num_sets; ++s)
+      {
+        results[s] = internals::evaluate_with(f, point, parameters + s, num_sets);
+      }
+  }
+}
+
+#endif
@@ -0,0 +1,403 @@
+#ifndef SIMBPOLIC_PARTIAL
+#define SIMBPOLIC_PARTIAL
+
+namespace Simbpolic
+{
+  /*!
+    \brief A polynomial in the first \p M dimensions with numeric coefficients,
+           where the power of `x_d` is at most the `d`-th of the \p degrees.
+
+    \details The coefficient of `x_1^e_1 * ... * x_M^e_M` is `coefficients[e_1 * stride[0] + ... + e_M * stride[M - 1]]`.
+
+    \remark This is also a number type for `internals::evaluate_with`,
+            which is how expressions get collapsed into it
+            (multiplications are truncated to the degrees, and divisions must be by constants).
+  */
+  template <indexer M, indexer ... degrees>
+  struct dense_polynomial
+  {
+    static_assert(sizeof...(degrees) == std::size_t(M), "There must be a degree for each dimension!");
+    static_assert(((degrees >= 0) && ...), "The degrees cannot be negative!");
+
+    static constexpr indexer num_dims = M;
+    static constexpr indexer degree[M] = {degrees...};
+    static constexpr std::size_t size = (std::size_t(1) * ... * std::size_t(degrees + 1));
+
+    SIMBPOLIC_CUDA_HOS_DEV static constexpr std::size_t stride(const indexer d)
+    {
+      std::size_t ret = 1;
+      for (indexer i = 0; i < d; ++i)
+        {
+          ret *= std::size_t(degree[i] + 1);
+        }
+      return ret;
+    }
+
+    Type coefficients[size] {};
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dense_polynomial()
+    {
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr dense_polynomial(const Type& val)
+    {
+      coefficients[0] = val;
+    }
+
+    /*!
+      \brief The polynomial `x_(d + 1)` (or zero, if its degree must be 0).
+    */
+    SIMBPOLIC_CUDA_HOS_DEV constexpr static dense_polynomial variable(const indexer d)
+    {
+      dense_polynomial ret;
+      if (degree[d] > 0)
+        {
+          ret.coefficients[stride(d)] = Type(1);
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr dense_polynomial operator+ (const dense_polynomial& a, const dense_polynomial& b)
+    {
+      dense_polynomial ret;
+      for (std::size_t i = 0; i < size; ++i)
+        {
+          ret.coefficients[i] = a.coefficients[i] + b.coefficients[i];
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr dense_polynomial operator- (const dense_polynomial& a, const dense_polynomial& b)
+    {
+      dense_polynomial ret;
+      for (std::size_t i = 0; i < size; ++i)
+        {
+          ret.coefficients[i] = a.coefficients[i] - b.coefficients[i];
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr dense_polynomial operator* (const dense_polynomial& a, const dense_polynomial& b)
+    //Since the index is linear in the exponents, the product of the terms i and j goes to i + j
+    //whenever it fits; the exponents of j are kept as a counter instead of being recomputed.
+    {
+      dense_polynomial ret;
+      for (std::size_t i = 0; i < size; ++i)
+        {
+          if (a.coefficients[i] == Type(0))
+            {
+              continue;
+            }
+          indexer room[M] {};
+          for (indexer d = 0; d < M; ++d)
+            {
+              room[d] = degree[d] - indexer((i / stride(d)) % std::size_t(degree[d] + 1));
+            }
+          indexer exps[M] {};
+          for (std::size_t j = 0; j < size; ++j)
+            {
+              bool fits = true;
+              for (indexer d = 0; d < M && fits; ++d)
+                {
+                  fits = (exps[d] <= room[d]);
+                }
+              if (fits)
+                {
+                  ret.coefficients[i + j] = ret.coefficients[i + j] + a.coefficients[i] * b.coefficients[j];
+                }
+              for (indexer d = 0; d < M && ++exps[d] > degree[d]; ++d)
+                {
+                  exps[d] = 0;
+                }
+            }
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr dense_polynomial operator/ (const dense_polynomial& a, const dense_polynomial& b)
+    //b should be a constant.
+    {
+      dense_polynomial ret;
+      for (std::size_t i = 0; i < size; ++i)
+        {
+          ret.coefficients[i] = a.coefficients[i] / b.coefficients[0];
+        }
+      return ret;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV friend constexpr Type value_of(const dense_polynomial& p)
+    //Only used for the dimensions that are constants.
+    {
+      return p.coefficients[0];
+    }
+
+    /*!
+      \brief Evaluates the polynomial at \p x (with `x[d]` being the value of `x_(d + 1)`), by nested Horner schemes.
+    */
+    template <indexer d = M - 1>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr Type evaluate(const Type* x, const std::size_t offset = 0) const
+    {
+      if constexpr (d < 0)
+        {
+          return coefficients[offset];
+        }
+      else
+        {
+          return horner<d, 0>(x, offset);
+        }
+    }
+
+    template <indexer d, indexer e>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr Type horner(const Type* x, const std::size_t offset) const
+    //The terms with powers of `x_(d + 1)` from e upwards, divided by `x_(d + 1)^e`,
+    //unrolled at compile-time so that the whole evaluation is straight-line code.
+    {
+      const Type here = evaluate<d - 1>(x, offset + std::size_t(e) * stride(d));
+      if constexpr (e == degree[d])
+        {
+          return here;
+        }
+      else
+        {
+          return here + x[d] * horner<d, e + 1>(x, offset);
+        }
+    }
+  };
+
+  namespace internals
+  {
+    template <class Func, indexer dim, std::size_t ... ds>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto collapsed_type(std::index_sequence<ds...>)
+    {
+      return dense_polynomial<indexer(sizeof...(ds)), (indexer(ds) + 1 == dim ? 0 : polynomial_degree<Func, indexer(ds) + 1>)...>{};
+    }
+
+    template <class Func, indexer dim, indexer d = 1>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static bool collapsible()
+    {
+      if constexpr (d > Func::max_dimension)
+        {
+          return true;
+        }
+      else
+        {
+          return (d == dim || polynomial_degree<Func, d> >= 0) && collapsible<Func, dim, d + 1>();
+        }
+    }
+
+    template <indexer ... values>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static indexer largest_of()
+    {
+      indexer ret = 0;
+      ((ret = max_of(ret, values)), ...);
+      return ret;
+    }
+  }
+
+  /*!
+    \brief A function where one of the coordinates has been fixed,
+           held as the coefficients of a polynomial in the remaining ones
+           for each of the cells delimited by their cut-off points.
+
+    \details There can be up to `max_cuts[d]` cut-off points along the dimension `d + 1`
+             (always 0 for the one that was fixed). The cells are numbered as
+             `piece_1 * cell_stride(0) + ... + piece_M * cell_stride(M - 1)`, where `piece_d` is the piece along `d`
+             (0 before the first cut-off point); the polynomial of each cell is expanded
+             around a point inside it (`anchors`), to keep the coefficients small.
+  */
+  template <class Poly, indexer dim, indexer ... max_cuts>
+  struct partial_function
+  {
+    static_assert(sizeof...(max_cuts) == std::size_t(Poly::num_dims), "There must be a number of cut-off points for each dimension!");
+
+    using polynomial_type = Poly;
+
+    static constexpr indexer num_dims = Poly::num_dims;
+    static constexpr indexer cut_capacity[num_dims] = {max_cuts...};
+    static constexpr indexer max_pieces = internals::largest_of<max_cuts...>() + 1;
+    static constexpr std::size_t num_cells = (std::size_t(1) * ... * std::size_t(max_cuts + 1));
+
+    SIMBPOLIC_CUDA_HOS_DEV static constexpr std::size_t cell_stride(const indexer d)
+    {
+      std::size_t ret = 1;
+      for (indexer i = 0; i < d; ++i)
+        {
+          ret *= std::size_t(cut_capacity[i] + 1);
+        }
+      return ret;
+    }
+
+    indexer num_cuts[num_dims] {};
+    Type cuts[num_dims][max_pieces] {};
+    Type anchors[num_dims][max_pieces] {};
+    Poly polynomials[num_cells] {};
+
+    /*!
+      \brief Evaluates the function, taking the values of the remaining dimensions in increasing order
+             (that is, skipping the one that was fixed).
+
+      \remark At the cut-off points, the average of the cells on both sides is taken,
+              as in the usual evaluation.
+    */
+    template <class ... Args>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr Type operator() (const Args& ... args) const
+    {
+      static_assert(indexer(sizeof...(Args)) + 1 >= num_dims, "There must be a value for every remaining dimension!");
+      const Type given[sizeof...(Args) + 1] = {Type(args)...};
+      Type point[num_dims] {};
+      indexer pieces[num_dims] {}, on_cut[num_dims] {};
+      indexer num_on_cut = 0;
+      for (indexer d = 0, i = 0; d < num_dims; ++d)
+        {
+          if (d + 1 == dim)
+            {
+              continue;
+            }
+          point[d] = given[i++];
+          if constexpr (num_cells == 1)
+            {
+              continue;
+            }
+          while (pieces[d] < num_cuts[d] && cuts[d][pieces[d]] < point[d])
+            {
+              ++pieces[d];
+            }
+          if (pieces[d] < num_cuts[d] && cuts[d][pieces[d]] == point[d])
+            {
+              on_cut[num_on_cut++] = d;
+            }
+        }
+      if constexpr (num_cells == 1)
+        {
+          return polynomials[0].evaluate(point);
+        }
+      else
+        {
+          Type ret = cell_value(pieces, point);
+          for (std::size_t side = 1; side < (std::size_t(1) << num_on_cut); ++side)
+            //Each bit chooses the piece before or after one of the cut-off points the point is on.
+            {
+              indexer chosen[num_dims] {};
+              for (indexer d = 0; d < num_dims; ++d)
+                {
+                  chosen[d] = pieces[d];
+                }
+              for (indexer k = 0; k < num_on_cut; ++k)
+                {
+                  chosen[on_cut[k]] += indexer((side >> k) & 1);
+                }
+              ret = ret + cell_value(chosen, point);
+            }
+          return (num_on_cut > 0 ? ret / Type(std::size_t(1) << num_on_cut) : ret);
+        }
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr Type cell_value(const indexer (&pieces)[num_dims], const Type (&point)[num_dims]) const
+    {
+      std::size_t cell = 0;
+      Type shifted[num_dims] {};
+      for (indexer d = 0; d < num_dims; ++d)
+        {
+          cell += std::size_t(pieces[d]) * cell_stride(d);
+          shifted[d] = point[d] - anchors[d][pieces[d]];
+        }
+      return polynomials[cell].evaluate(shifted);
+    }
+  };
+
+  namespace internals
+  {
+    template <class Func, indexer dim, std::size_t ... ds>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto partial_type(std::index_sequence<ds...> seq)
+    {
+      using poly_type = decltype(collapsed_type<Func, dim>(seq));
+      return partial_function<poly_type, dim, (indexer(ds) + 1 == dim ? 0 : cut_count<Func, indexer(ds) + 1>)...>{};
+    }
+
+    template <indexer dim, class Func, class Partial, std::size_t ... ds>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void partial_cuts(const Func& f, Partial& p, std::index_sequence<ds...>)
+    //Fills in the cut-off points (and the anchors of the pieces between them) along every dimension but dim.
+    {
+      ((indexer(ds) + 1 != dim ? (void) (p.num_cuts[ds] = sorted_cuts<indexer(ds) + 1>(f, p.cuts[ds])) : (void) 0), ...);
+      for (indexer d = 0; d < Partial::num_dims; ++d)
+        {
+          const indexer n = p.num_cuts[d];
+          for (indexer piece = 0; piece <= n; ++piece)
+            {
+              if (n == 0)
+                {
+                  p.anchors[d][piece] = Type(0);
+                }
+              else if (piece == 0)
+                {
+                  p.anchors[d][piece] = p.cuts[d][0] - Type(1);
+                }
+              else if (piece == n)
+                {
+                  p.anchors[d][piece] = p.cuts[d][n - 1] + Type(1);
+                }
+              else
+                {
+                  p.anchors[d][piece] = (p.cuts[d][piece - 1] + p.cuts[d][piece]) / Type(2);
+                }
+            }
+        }
+    }
+  }
+
+  /*!
+    \brief Fixes the coordinate \p dim of \p f to \p value, collapsing everything else
+           into a polynomial in the remaining coordinates for each cell
+           delimited by the cut-off points along them.
+
+    \remark The expression is only evaluated once per cell (with polynomials instead of numbers,
+            at a point inside the cell so that the branched functions pick its pieces),
+            and the branched functions along \p dim are resolved then,
+            so evaluating the result only costs finding the cell and evaluating its polynomial.
+            Functions that are not branched along the remaining dimensions give a single cell.
+
+    \pre \p f must be a polynomial (in each of its pieces) along every other dimension,
+         with no `Stored` constants (see `bind`).
+  */
+  template <class Func, indexer dim, class Val>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto partial(const Func& f, const Var<dim>& var, const Val& value)
+  {
+    static_assert(internals::collapsible<Func, dim>(),
+                  "The function must be a polynomial along the dimensions that are not fixed!");
+
+    constexpr indexer num_dims = internals::max_of(Func::max_dimension, dim);
+    using result_type = decltype(internals::partial_type<Func, dim>(std::make_index_sequence<num_dims>{}));
+    using poly_type = typename result_type::polynomial_type;
+
+    result_type ret {};
+    internals::partial_cuts<dim>(f, ret, std::make_index_sequence<num_dims>{});
+
+    for (std::size_t cell = 0; cell < result_type::num_cells; ++cell)
+      {
+        poly_type point[num_dims] {};
+        bool exists = true;
+        for (indexer d = 0; d < num_dims; ++d)
+          {
+            const indexer piece = indexer((cell / result_type::cell_stride(d)) % std::size_t(result_type::cut_capacity[d] + 1));
+            exists = exists && piece <= ret.num_cuts[d];
+            if (d + 1 == dim)
+              {
+                point[d] = poly_type(Type(value));
+              }
+            else if (exists)
+              {
+                point[d] = poly_type::variable(d);
+                point[d].coefficients[0] = ret.anchors[d][piece];
+              }
+          }
+        //Repeated cut-off points leave some of the cells empty.
+        if (exists)
+          {
+            ret.polynomials[cell] = internals::evaluate_with(f, point);
+          }
+      }
+    return ret;
+  }
+}
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef SIMBPOLIC_PIECEWISE
+#define SIMBPOLIC_PIECEWISE
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    /*!
+      \brief A piecewise polynomial along one dimension with exact coefficients,
+             with at most \p C cut-off points and pieces of degree at most \p D.
+
+      \details The pieces are numbered from 0 (before `cuts[0]`) to `num_cuts` (after `cuts[num_cuts - 1]`),
+               and the coefficient of `x^k` in piece `i` is `coefficients[i][k]`.
+               The cut-off points are always sorted and distinct.
+    */
+    template <indexer C, indexer D>
+    struct exact_piecewise
+    {
+      static constexpr indexer max_cuts = C;
+      static constexpr indexer degree = D;
+
+      indexer num_cuts = 0;
+      exact_fraction cuts[C > 0 ? C : 1] {};
+      exact_fraction coefficients[C + 1][D + 1] {};
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr indexer piece_at(const exact_fraction& x) const
+      //x should not be a cut-off point.
+      {
+        indexer ret = 0;
+        while (ret < num_cuts && cuts[ret] < x)
+          {
+            ++ret;
+          }
+        return ret;
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr exact_fraction point_inside(const indexer piece) const
+      //Some point strictly inside a given piece.
+      {
+        if (num_cuts == 0)
+          {
+            return exact_fraction(0);
+          }
+        else if (piece == 0)
+          {
+            return cuts[0] - exact_fraction(1);
+          }
+        else if (piece == num_cuts)
+          {
+            return cuts[num_cuts - 1] + exact_fraction(1);
+          }
+        else
+          {
+            return (cuts[piece - 1] + cuts[piece]) * exact_fraction(1, 2);
+          }
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr bool is_zero_piece(const indexer piece) const
+      {
+        for (indexer k = 0; k <= D; ++k)
+          {
+            if (!coefficients[piece][k].is_zero())
+              {
+                return false;
+              }
+          }
+        return true;
+      }
+
+      SIMBPOLIC_CUDA_HOS_DEV constexpr bool is_compactly_supported() const
+      {
+        return is_zero_piece(0) && is_zero_piece(num_cuts);
+      }
+    };
+
+    /*!
+      \brief Writes the sorted union of the sorted (and distinct) \p a and \p b to \p out,
+             returning the number of elements.
+    */
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static indexer merge_cuts(const exact_fraction* a, const indexer num_a,
+                                                                     const exact_fraction* b, const indexer num_b,
+                                                                     exact_fraction* out)
+    {
+      indexer i = 0, j = 0, count = 0;
+      while (i < num_a || j < num_b)
+        {
+          if (j == num_b || (i < num_a && a[i] < b[j]))
+            {
+              out[count++] = a[i++];
+            }
+          else if (i == num_a || b[j] < a[i])
+            {
+              out[count++] = b[j++];
+            }
+          else
+            {
+              out[count++] = a[i++];
+              ++j;
+            }
+        }
+      return count;
+    }
+
+    /*!
+      \brief Applies \p op to \p a and \p b piece by piece, over the union of their cut-off points.
+
+      \remark For divisions, the pieces of \p b must be constants.
+    */
+    template <indexer C, indexer D>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static exact_piecewise<C, D> combine_pieces(const exact_piecewise<C, D>& a, const exact_piecewise<C, D>& b,
+                                                                                       const operation_kind op)
+    {
+      exact_fraction merged[2 * C + 1] {};
+      exact_piecewise<C, D> ret {};
+      ret.num_cuts = merge_cuts(a.cuts, a.num_cuts, b.cuts, b.num_cuts, merged);
+      for (indexer i = 0; i < ret.num_cuts; ++i)
+        {
+          ret.cuts[i] = merged[i];
+        }
+      for (indexer i = 0; i <= ret.num_cuts; ++i)
+        {
+          const exact_fraction point = ret.point_inside(i);
+          const indexer piece_a = a.piece_at(point), piece_b = b.piece_at(point);
+          for (indexer k = 0; k <= D; ++k)
+            {
+              switch (op)
+                {
+                  case operation_kind::add:
+                    ret.coefficients[i][k] = a.coefficients[piece_a][k] + b.coefficients[piece_b][k];
+                    break;
+                  case operation_kind::subtract:
+                    ret.coefficients[i][k] = a.coefficients[piece_a][k] - b.coefficients[piece_b][k];
+                    break;
+                  case operation_kind::multiply:
+                    for (indexer l = 0; l <= k; ++l)
+                      {
+                        ret.coefficients[i][k] = ret.coefficients[i][k] + a.coefficients[piece_a][l] * b.coefficients[piece_b][k - l];
+                      }
+                    break;
+                  case operation_kind::divide:
+                    ret.coefficients[i][k] = a.coefficients[piece_a][k] / b.coefficients[piece_b][0];
+                    break;
+                }
+            }
+        }
+      return ret;
+    }
+
+    /*!
+      \brief Gives \p below before \p cut and \p above after it.
+    */
+    template <indexer C, indexer D>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static exact_piecewise<C, D> select_pieces(const exact_piecewise<C, D>& below, const exact_fraction& cut,
+                                                                                      const exact_piecewise<C, D>& above)
+    {
+      exact_fraction partial[2 * C + 1] {}, merged[2 * C + 2] {};
+      const indexer num_partial = merge_cuts(below.cuts, below.num_cuts, above.cuts, above.num_cuts, partial);
+      exact_piecewise<C, D> ret {};
+      ret.num_cuts = merge_cuts(partial, num_partial, &cut, 1, merged);
+      for (indexer i = 0; i < ret.num_cuts; ++i)
+        {
+          ret.cuts[i] = merged[i];
+        }
+      for (indexer i = 0; i <= ret.num_cuts; ++i)
+        {
+          const exact_fraction point = ret.point_inside(i);
+          const auto& source = (point < cut ? below : above);
+          const indexer piece = source.piece_at(point);
+          for (indexer k = 0; k <= D; ++k)
+            {
+              ret.coefficients[i][k] = source.coefficients[piece][k];
+            }
+        }
+      return ret;
+    }
+
+    /*!
+      \brief Converts \p f, a (piecewise) polynomial along \p dim with exact coefficients and cut-off points,
+             into an `exact_piecewise<C, D>`.
+
+      \pre \p C and \p D must be at least `cut_count<Func, dim>` and `polynomial_degree<Func, dim>`.
+    */
+    template <indexer dim, indexer C, indexer D, class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static exact_piecewise<C, D> to_exact_piecewise(const Func& f)
+    {
+      if constexpr (is_exact<Func>)
+        {
+          exact_piecewise<C, D> ret {};
+          ret.coefficients[0][0] = exact_value_of(f);
+          return ret;
+        }
+      else if constexpr (is_op_func<Func>)
+        {
+          return combine_pieces(to_exact_piecewise<dim, C, D>(f.f1()), to_exact_piecewise<dim, C, D>(f.f2()), operation_of<Func>);
+        }
+      else if constexpr (is_interval_function<Func>)
+        {
+          static_assert(branch_dimension<Func> == dim, "Only functions of a single variable can be converted!");
+          static_assert(is_exact<std::decay_t<decltype(f.lower_cut())>> && is_exact<std::decay_t<decltype(f.upper_cut())>>, "The cut-off points must be exact!");
+          const auto upper = select_pieces(to_exact_piecewise<dim, C, D>(f.f2()), exact_value_of(f.upper_cut()),
+                                           to_exact_piecewise<dim, C, D>(f.f3()));
+          return select_pieces(to_exact_piecewise<dim, C, D>(f.f1()), exact_value_of(f.lower_cut()), upper);
+        }
+      else if constexpr (branch_dimension<Func> != 0)
+        {
+          static_assert(branch_dimension<Func> == dim, "Only functions of a single variable can be converted!");
+          static_assert(is_exact<std::decay_t<decltype(f.cut())>>, "The cut-off points must be exact!");
+          return select_pieces(to_exact_piecewise<dim, C, D>(f.f1()), exact_value_of(f.cut()), to_exact_piecewise<dim, C, D>(f.f2()));
+        }
+      else
+        {
+          static_assert(polynomial_degree<Func, dim> >= 0 && Func::template has_dimension<dim>() &&
+                        Func::min_dimension == dim && Func::max_dimension == dim,
+                        "Only (piecewise) polynomials with exact coefficients can be converted!");
+          exact_piecewise<C, D> ret {};
+          ret.coefficients[0][polynomial_degree<Func, dim>] = exact_fraction(1);
+          return ret;
+        }
+    }
+
+    /*!
+      \brief Holds the `exact_piecewise` representation of \p Func (which must be default-constructible)
+             as a compile-time constant.
+    */
+    template <class Func, indexer dim>
+    struct exact_piecewise_of
+    {
+      static constexpr indexer max_cuts = cut_count<Func, dim>;
+      static constexpr indexer degree = polynomial_degree<Func, dim>;
+      static_assert(degree >= 0, "Only (piecewise) polynomials can be converted!");
+      static constexpr exact_piecewise<max_cuts, degree> value = to_exact_piecewise<dim, max_cuts, degree>(Func{});
+    };
+
+    template <indexer dim, class Data, indexer piece, indexer k>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto exact_term()
+    {
+      constexpr exact_fraction coefficient = Data::value.coefficients[piece][k];
+      static_assert(coefficient.num <= std::numeric_limits<indexer>::max() && coefficient.num >= std::numeric_limits<indexer>::min() &&
+                    coefficient.den <= std::numeric_limits<indexer>::max(), "The coefficients do not fit in an exact number!");
+      if constexpr (coefficient.is_zero())
+        {
+          return Zero{};
+        }
+      else if constexpr (k == 0)
+        {
+          return Rational<indexer(coefficient.num), indexer(coefficient.den)>::simplify();
+        }
+      else
+        {
+          return Rational<indexer(coefficient.num), indexer(coefficient.den)>::simplify() * Monomial<k, dim>{};
+        }
+    }
+
+    template <indexer dim, class Data, indexer piece, indexer ... ks>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto exact_piece(std::integer_sequence<indexer, ks...>)
+    {
+      return (Zero{} + ... + exact_term<dim, Data, piece, ks>());
+    }
+
+    template <indexer dim, class Data, indexer i>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto exact_branch_argument()
+    //The arguments of branched alternate between pieces (even i) and cut-off points (odd i).
+    {
+      if constexpr (i % 2)
+        {
+          constexpr exact_fraction cut = Data::value.cuts[i/2];
+          static_assert(cut.num <= std::numeric_limits<indexer>::max() && cut.num >= std::numeric_limits<indexer>::min() &&
+                        cut.den <= std::numeric_limits<indexer>::max(), "The cut-off points do not fit in an exact number!");
+          return Rational<indexer(cut.num), indexer(cut.den)>{};
+        }
+      else
+        {
+          return exact_piece<dim, Data, i/2>(std::make_integer_sequence<indexer, std::decay_t<decltype(Data::value)>::degree + 1>{});
+        }
+    }
+
+    template <indexer dim, class Data, indexer ... is>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto exact_branches(std::integer_sequence<indexer, is...>)
+    {
+      return branched(Var<dim>{}, exact_branch_argument<dim, Data, is>()...);
+    }
+
+    /*!
+      \brief Gives the function, along \p dim, described by `Data::value` (an `exact_piecewise` known at compile-time).
+    */
+    template <indexer dim, class Data>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto from_exact_piecewise()
+    {
+      return exact_branches<dim, Data>(std::make_integer_sequence<indexer, 2 * Data::value.num_cuts + 1>{});
+    }
+  }
+}
+
+#endif
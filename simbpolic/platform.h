@@ -0,0 +1,42 @@
+#ifndef SIMBPOLIC_PLATFORM
+#define SIMBPOLIC_PLATFORM
+
+#if __CUDA_ARCH__
+#define SIMBPOLIC_CUDA_AVAILABLE 1
+#elif __CUDA__
+#define SIMBPOLIC_CUDA_AVAILABLE 1
+#else
+#define SIMBPOLIC_CUDA_AVAILABLE 0
+#endif
+
+//For maximum interoperatability between CUDA and normal code.
+#if SIMBPOLIC_CUDA_AVAILABLE
+#define SIMBPOLIC_CUDA_HOS_DEV __host__ __device__
+#else
+#define SIMBPOLIC_CUDA_HOS_DEV
+#endif
+
+#if SIMBPOLIC_CUDA_AVAILABLE
+#define SIMBPOLIC_CUDA_ONLY_HOS __host__
+#else
+#define SIMBPOLIC_CUDA_ONLY_HOS
+#endif
+
+#if SIMBPOLIC_CUDA_AVAILABLE
+#define SIMBPOLIC_CUDA_ONLY_DEV __device__
+#else
+#define SIMBPOLIC_CUDA_ONLY_DEV
+#endif
+
+//For the numeric evaluation paths, where the whole expression should collapse into straight-line code.
+#if SIMBPOLIC_CUDA_AVAILABLE
+#define SIMBPOLIC_FORCE_INLINE __forceinline__
+#elif defined(_MSC_VER)
+#define SIMBPOLIC_FORCE_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#define SIMBPOLIC_FORCE_INLINE __attribute__((always_inline))
+#else
+#define SIMBPOLIC_FORCE_INLINE
+#endif
+
+#endif
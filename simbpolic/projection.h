@@ -0,0 +1,134 @@
+#ifndef SIMBPOLIC_PROJECTION
+#define SIMBPOLIC_PROJECTION
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    template <class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto mixed_primitive(const Func& f)
+    {
+      return f;
+    }
+
+    /*!
+      \brief Takes the primitive of \p f along every dimension in the grid specification,
+             giving a function whose alternating sum over the corners of a cell
+             is the integral of \p f over that cell.
+    */
+    template <class Func, indexer dim, class ... Others>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static auto mixed_primitive(const Func& f, const Var<dim> &var, const Type* nodes,
+                                                                        const std::size_t num_nodes, const Others& ... rest)
+    {
+      return mixed_primitive(f.template primitive<dim>(), rest...);
+    }
+
+    template <std::size_t N>
+    SIMBPOLIC_CUDA_HOS_DEV inline static void unpack_grid(indexer (&dims)[N], const Type* (&nodes)[N], std::size_t (&counts)[N],
+                                                          const std::size_t i)
+    {
+    }
+
+    template <std::size_t N, indexer dim, class ... Others>
+    SIMBPOLIC_CUDA_HOS_DEV inline static void unpack_grid(indexer (&dims)[N], const Type* (&nodes)[N], std::size_t (&counts)[N],
+                                                          const std::size_t i, const Var<dim> &var, const Type* these_nodes,
+                                                          const std::size_t num_nodes, const Others& ... rest)
+    {
+      dims[i] = dim;
+      nodes[i] = these_nodes;
+      counts[i] = num_nodes;
+      unpack_grid(dims, nodes, counts, i + 1, rest...);
+    }
+  }
+
+  /*!
+    \brief Writes to \p averages the exact average of \p f over each cell of a rectilinear grid.
+
+    \details The grid is given, after \p averages, by a `Var<dim>`, a pointer to the (strictly increasing) nodes
+             along that dimension and the number of nodes, repeated for as many dimensions as needed.
+             The averages are stored with the first dimension varying fastest,
+             so, for nodes `x[0..nx)` and `y[0..ny)`, the cell `[x[i], x[i+1]] x [y[j], y[j+1]]`
+             ends up at `averages[i + (nx - 1) * j]`.
+
+    \remark The mixed primitive along all the dimensions is computed symbolically once
+            and evaluated once per grid node; the cell integrals are then obtained
+            by differencing neighbouring nodes along each dimension in turn,
+            which is exact (up to rounding) even for branched functions
+            since their primitives are continuous across the cut-off points.
+
+    \pre \p f may only depend on the dimensions of the grid.
+  */
+  template <class Func, class ... Grid>
+  inline static void project_cells(const Func& f, Type* averages, const Grid& ... grid)
+  {
+    static_assert(sizeof...(Grid) % 3 == 0 && sizeof...(Grid) > 0, "Each dimension must be specified with its nodes and their number!");
+    static_assert(internals::integrates_all_dimensions<Func, 1, Grid...>(), "The function may only depend on the dimensions of the grid!");
+
+    constexpr std::size_t num_dims = sizeof...(Grid) / 3;
+    constexpr indexer num_coords = internals::max_of(Func::max_dimension, internals::max_var_dimension<Grid...>());
+
+    indexer dims[num_dims] {};
+    const Type* nodes[num_dims] {};
+    std::size_t counts[num_dims] {}, strides[num_dims] {};
+    internals::unpack_grid(dims, nodes, counts, 0, grid...);
+
+    std::size_t total = 1;
+    for (std::size_t d = 0; d < num_dims; ++d)
+      {
+        if (counts[d] < 2)
+          {
+            return;
+          }
+        strides[d] = total;
+        total *= counts[d];
+      }
+
+    const auto prim = internals::mixed_primitive(f, grid...);
+
+    std::vector<Type> values(total);
+    Type point[num_coords] {};
+
+    for (std::size_t i = 0; i < total; ++i)
+      {
+        for (std::size_t d = 0; d < num_dims; ++d)
+          {
+            point[dims[d] - 1] = nodes[d][(i / strides[d]) % counts[d]];
+          }
+        values[i] = internals::evaluate_with(prim, point);
+      }
+
+    for (std::size_t d = 0; d < num_dims; ++d)
+      {
+        for (std::size_t i = 0; i < total; ++i)
+          {
+            if ((i / strides[d]) % counts[d] + 1 < counts[d])
+              {
+                values[i] = values[i + strides[d]] - values[i];
+                //In increasing order, so values[i + strides[d]] has not been differenced yet.
+              }
+          }
+      }
+
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < total; ++i)
+      {
+        Type volume(1);
+        bool is_cell = true;
+        for (std::size_t d = 0; d < num_dims && is_cell; ++d)
+          {
+            const std::size_t j = (i / strides[d]) % counts[d];
+            is_cell = j + 1 < counts[d];
+            if (is_cell)
+              {
+                volume = volume * (nodes[d][j + 1] - nodes[d][j]);
+              }
+          }
+        if (is_cell)
+          {
+            averages[out++] = values[i] / volume;
+          }
+      }
+  }
+}
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef SIMBPOLIC_QUADRATURE
+#define SIMBPOLIC_QUADRATURE
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static long double series_cos(const long double x)
+    //Only good enough for 0 <= x <= pi,
+    //which is all we need for the initial guesses of the nodes.
+    {
+      const long double x2 = x * x;
+      long double term = 1, sum = 1;
+      for (indexer i = 1; i < 40; ++i)
+        {
+          term *= -x2 / ((2 * i - 1) * (2 * i));
+          sum += term;
+        }
+      return sum;
+    }
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void legendre(const indexer n, const long double x, long double& p, long double& deriv)
+    //Evaluates the Legendre polynomial of order n (> 0) and its derivative at x.
+    {
+      long double p_prev = 1;
+      p = x;
+      for (indexer k = 1; k < n; ++k)
+        {
+          const long double p_next = ((2 * k + 1) * x * p - k * p_prev) / (k + 1);
+          p_prev = p;
+          p = p_next;
+        }
+      deriv = n * (x * p - p_prev) / (x * x - 1);
+    }
+
+    template <indexer n>
+    struct gauss_legendre_rule
+    {
+      long double nodes[n];
+      long double weights[n];
+    };
+
+    template <indexer n>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static gauss_legendre_rule<n> make_gauss_legendre_rule()
+    {
+      constexpr long double pi = 3.141592653589793238462643383279502884L;
+      constexpr long double tolerance = 4 * std::numeric_limits<long double>::epsilon();
+      gauss_legendre_rule<n> ret{};
+      for (indexer i = 0; i < n; ++i)
+        {
+          long double x = series_cos(pi * (i + 0.75L) / (n + 0.5L));
+          long double p = 0, deriv = 0;
+          for (indexer iter = 0; iter < 100; ++iter)
+            {
+              legendre(n, x, p, deriv);
+              const long double dx = p / deriv;
+              x -= dx;
+              if (dx <= tolerance && dx >= -tolerance)
+                {
+                  break;
+                }
+            }
+          legendre(n, x, p, deriv);
+          ret.nodes[i] = x;
+          ret.weights[i] = 2 / ((1 - x * x) * deriv * deriv);
+        }
+      return ret;
+    }
+
+    /*!
+      \brief The nodes (in [-1, 1]) and weights of the Gauss-Legendre rule with \p n points,
+             which is exact for polynomials up to degree `2 n - 1`.
+    */
+    template <indexer n>
+    struct gauss_legendre
+    {
+      static_assert(n > 0, "Quadrature rules need at least one point!");
+      static constexpr gauss_legendre_rule<n> rule = make_gauss_legendre_rule<n>();
+    };
+
+    template <class T>
+    inline static constexpr indexer var_dimension = 0;
+
+    template <indexer dim>
+    inline static constexpr indexer var_dimension<Var<dim>> = dim;
+
+    template <class ... Others>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static indexer max_var_dimension()
+    {
+      indexer ret = 0;
+      ((ret = max_of(ret, var_dimension<Others>)), ...);
+      return ret;
+    }
+
+    template <class Func, indexer dim, class ... Others>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static bool integrates_all_dimensions()
+    {
+      if constexpr (dim > Func::max_dimension)
+        {
+          return true;
+        }
+      else
+        {
+          return (!Func::template has_dimension<dim>() || ((var_dimension<Others> == dim) || ...)) &&
+                 integrates_all_dimensions<Func, dim + 1, Others...>();
+        }
+    }
+
+    template <class Func, indexer N>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Type quadrature(const Func& f, Type (&point)[N])
+    {
+      return evaluate_with(f, point);
+    }
+
+    template <class Func, indexer N, indexer dim, class StartT, class EndT, class ... Others>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Type quadrature(const Func& f, Type (&point)[N], const Var<dim> &var,
+                                                                   const StartT &start, const EndT &end, const Others& ... rest)
+    {
+      static_assert(is_numeric<StartT> && is_numeric<EndT>, "Quadrature is only supported over boxes (with numeric limits)!");
+
+      constexpr indexer degree = polynomial_degree<Func, dim>;
+      static_assert(degree >= 0, "Quadrature is only supported for (piecewise) polynomial integrands!");
+
+      using rule_type = gauss_legendre<degree/2 + 1>;
+
+      Type splits[cut_count<Func, dim> + 2] {};
+      const indexer num_cuts = sorted_cuts<dim>(f, splits + 1);
+
+      const Type a(start), b(end);
+      const bool reversed = b < a;
+      const Type low = (reversed ? b : a), high = (reversed ? a : b);
+
+      indexer num_splits = 1;
+      splits[0] = low;
+      for (indexer i = 0; i < num_cuts; ++i)
+        {
+          if (splits[i + 1] > low && splits[i + 1] < high)
+            {
+              splits[num_splits++] = splits[i + 1];
+            }
+        }
+      splits[num_splits++] = high;
+
+      Type ret(0);
+      for (indexer i = 0; i + 1 < num_splits; ++i)
+        {
+          const Type half_width = (splits[i + 1] - splits[i]) / Type(2);
+          const Type center = (splits[i + 1] + splits[i]) / Type(2);
+          for (indexer k = 0; k < degree/2 + 1; ++k)
+            {
+              point[dim - 1] = center + half_width * Type(rule_type::rule.nodes[k]);
+              ret = ret + Type(rule_type::rule.weights[k]) * half_width * quadrature(f, point, rest...);
+            }
+        }
+      return (reversed ? -ret : ret);
+    }
+  }
+
+  /*!
+    \brief Integrates \p f over a box using Gauss-Legendre quadrature,
+           splitting the integration at the cut-off points of the branched functions
+           and using, along each dimension, the smallest rule that is exact
+           for the degree of \p f (see `polynomial_degree`).
+
+    \remark Arguments as in `integrate`, but the limits must be numbers
+            and \p f may only depend on the dimensions that are integrated,
+            so that the result is always a number.
+            No primitives are computed: \p f is just evaluated at the quadrature nodes.
+  */
+  template <class Func, indexer dim, class StartT, class EndT, class ... Others>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Type integrate_quadrature(const Func& f, const Var<dim> &var,
+                                                                           const StartT &start, const EndT &end, const Others& ... rest)
+  {
+    static_assert(sizeof...(Others) % 3 == 0, "Each dimension must be specified with its limits of integration!");
+    static_assert(internals::integrates_all_dimensions<Func, 1, Var<dim>, Others...>(),
+                  "Quadrature must integrate along every dimension the function depends on!");
+
+    constexpr indexer num_coords = internals::max_of(internals::max_of(Func::max_dimension, dim),
+                                                     internals::max_var_dimension<Others...>());
+    Type point[num_coords] {};
+    return internals::quadrature(f, point, var, start, end, rest...);
+  }
+}
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef SIMBPOLIC_REGISTRY
+#define SIMBPOLIC_REGISTRY
+
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+#include "../simbpolic.h"
+#include "any_function.h"
+
+namespace Simbpolic
+{
+  /*!
+    \brief The 64-bit FNV-1a hash of \p name, used as the stable identifier of a kernel in the `kernel_registry`.
+
+    \details Being `constexpr`, it can be computed at compile-time, for instance to `switch` on the identifiers
+             or to look up a kernel without hashing its name at run-time.
+  */
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static std::uint64_t kernel_id(const char* name)
+  {
+    std::uint64_t ret = 14695981039346656037ull;
+    for (; *name != '\0'; ++name)
+      {
+        ret = (ret ^ std::uint64_t(static_cast<unsigned char>(*name))) * 1099511628211ull;
+      }
+    return ret;
+  }
+
+  namespace internals
+  {
+    /*!
+      \brief The maximum number of kernels in a `kernel_registry`.
+    */
+    inline static constexpr std::size_t kernel_registry_capacity = 256;
+  }
+
+  /*!
+    \brief Maps the names (through `kernel_id`) of precompiled kernels to the `any_function`s that evaluate them in batches.
+
+    \details The entries are kept in a fixed-size open addressing table inside the registry itself,
+             so registering does not allocate and looking up takes constant time.
+             The kernels are usually added at static initialization, through `SIMBPOLIC_REGISTER_KERNEL`,
+             to the `global` registry (in which case the kernels themselves are kept in static storage as well).
+
+    \remark Registration is not synchronized: it should be done before looking up from several threads
+            (as is the case with static initialization).
+  */
+  class kernel_registry
+  {
+    public:
+
+    static constexpr std::size_t capacity = internals::kernel_registry_capacity;
+
+    /*!
+      \brief The registry used by `SIMBPOLIC_REGISTER_KERNEL`.
+
+      \remark Constructed on first use, so it can be used from the static initialization of any translation unit.
+    */
+    static kernel_registry& global()
+    {
+      static kernel_registry registry;
+      return registry;
+    }
+
+    /*!
+      \brief Registers \p function with the given \p name, which must outlive the registry (such as a string literal),
+             as must \p function.
+
+      \throw std::invalid_argument if a different kernel has already been registered with the same identifier.
+      \throw std::length_error if the registry is full.
+    */
+    bool add(const char* name, const any_function* function)
+    {
+      const std::uint64_t id = kernel_id(name);
+      for (std::size_t i = 0, pos = slot_of(id); i < capacity; ++i, pos = (pos + 1) % capacity)
+        {
+          entry& e = m_entries[pos];
+          if (e.function == nullptr)
+            {
+              e.id = id;
+              e.name = name;
+              e.function = function;
+              ++m_size;
+              return true;
+            }
+          else if (e.id == id)
+            {
+              if (e.function == function)
+                {
+                  return true;
+                }
+              throw std::invalid_argument("A kernel has already been registered with the same identifier!");
+            }
+        }
+      throw std::length_error("The kernel registry is full!");
+    }
+
+    /*!
+      \brief The kernel with the identifier \p id, or `nullptr` if there is none.
+    */
+    const any_function* find(const std::uint64_t id) const
+    {
+      const entry* e = lookup(id);
+      return (e == nullptr ? nullptr : e->function);
+    }
+
+    const any_function* find(const char* name) const
+    {
+      return find(kernel_id(name));
+    }
+
+    /*!
+      \brief The name the kernel with the identifier \p id was registered with, or `nullptr` if there is none.
+    */
+    const char* name_of(const std::uint64_t id) const
+    {
+      const entry* e = lookup(id);
+      return (e == nullptr ? nullptr : e->name);
+    }
+
+    std::size_t size() const
+    {
+      return m_size;
+    }
+
+    private:
+
+    struct entry
+    {
+      std::uint64_t id = 0;
+      const char* name = nullptr;
+      const any_function* function = nullptr;
+    };
+
+    entry m_entries[capacity] {};
+    std::size_t m_size = 0;
+
+    static std::size_t slot_of(const std::uint64_t id)
+    {
+      //The low bits of FNV-1a are well mixed.
+      return std::size_t(id % capacity);
+    }
+
+    const entry* lookup(const std::uint64_t id) const
+    {
+      for (std::size_t i = 0, pos = slot_of(id); i < capacity; ++i, pos = (pos + 1) % capacity)
+        {
+          const entry& e = m_entries[pos];
+          if (e.function == nullptr)
+            {
+              return nullptr;
+            }
+          else if (e.id == id)
+            {
+              return &e;
+            }
+        }
+      return nullptr;
+    }
+  };
+}
+
+/*!
+  \brief Registers the function given by the expression after \p ID (an identifier, which is also the name of the kernel)
+         in `kernel_registry::global()` at static initialization, so that it can be looked up by name
+         (or by `kernel_id("ID")`) by code that does not instantiate its type.
+
+  \details The function is kept in static storage, whatever its size, so registering never allocates.
+           The macro defines `inline` variables named after \p ID (at namespace scope), so it may be used in a header
+           included by several translation units: there is still a single kernel, registered once per program.
+           As with any other `inline` variable, every translation unit must then see the same expression.
+
+  \remark The expression is the last argument so that it may contain commas.
+          Since `any_function` provides the derivatives and integrals in batches,
+          registering a kernel also makes those available.
+*/
+#define SIMBPOLIC_REGISTER_KERNEL(ID, ...)                                                                           \
+  inline const auto simbpolic_kernel_model_##ID = ::Simbpolic::internals::make_any_function_model(__VA_ARGS__);    \
+  inline const ::Simbpolic::any_function simbpolic_kernel_##ID =                                                   \
+    ::Simbpolic::any_function::referring_to(simbpolic_kernel_model_##ID);                                          \
+  inline const bool simbpolic_kernel_added_##ID = ::Simbpolic::kernel_registry::global().add(#ID, &simbpolic_kernel_##ID);
+
+#endif
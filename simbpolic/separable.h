@@ -0,0 +1,67 @@
+#ifndef SIMBPOLIC_SEPARABLE
+#define SIMBPOLIC_SEPARABLE
+
+namespace Simbpolic
+{
+  template <class T>
+  inline static constexpr bool is_sum = std::is_base_of_v<mult_distributable, std::decay_t<T>>;
+
+  template <class T>
+  inline static constexpr bool is_product = false;
+
+  template <class T>
+  inline static constexpr bool is_product<const T> = is_product<T>;
+
+  template <class A, class B>
+  inline static constexpr bool is_product<func_mul<A, B>> = true;
+
+  namespace internals
+  {
+    /*!
+      \brief Splits a (possibly nested) product into the factors that depend on \p dim
+             and the ones that don't, returning them as the elements 0 and 1 of a `func_holder`.
+
+      \remark Anything that is not a `func_mul` is treated as a single factor.
+    */
+    template <indexer dim, class Func>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline auto split_along_dim(const Func& f)
+    {
+      if constexpr (is_product<Func>)
+        {
+          const auto first = split_along_dim<dim>(f.f1());
+          const auto second = split_along_dim<dim>(f.f2());
+          const auto with_dim = first.template get<0>() * second.template get<0>();
+          const auto without_dim = first.template get<1>() * second.template get<1>();
+          return func_holder<decltype(with_dim), decltype(without_dim)>{with_dim, without_dim};
+        }
+      else if constexpr (Func::template has_dimension<dim>())
+        {
+          return func_holder<Func, One>{f, One{}};
+        }
+      else
+        {
+          return func_holder<One, Func>{One{}, f};
+        }
+    }
+
+    template <indexer dim, class Func>
+    using dependent_factor_type = std::decay_t<decltype(split_along_dim<dim>(std::declval<Func>()).template get<0>())>;
+
+    template <indexer dim, class Func>
+    using independent_factor_type = std::decay_t<decltype(split_along_dim<dim>(std::declval<Func>()).template get<1>())>;
+  }
+
+  /*!
+    \brief Is `true` if \p Func is a product where at least one of the factors
+           does not depend on \p dim (and at least one does),
+           which means the integration along \p dim can be performed
+           on the dependent factors alone.
+  */
+  template <class Func, indexer dim>
+  inline static constexpr bool is_separable_along = is_product<Func> &&
+                                                    Func::template has_dimension<dim>() &&
+                                                    !std::is_same_v<internals::independent_factor_type<dim, Func>, One>;
+
+}
+
+#endif
@@ -0,0 +1,487 @@
+#ifndef SIMBPOLIC_SERIALIZE
+#define SIMBPOLIC_SERIALIZE
+
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+#include "../simbpolic.h"
+#include "dynamic.h"
+
+namespace Simbpolic
+{
+  /*!
+    \brief The start of a serialized runtime expression (see `serialize`).
+  */
+  struct serialized_header
+  {
+    char magic[8] = {'S', 'I', 'M', 'B', 'D', 'A', 'G', '\0'};
+    std::uint32_t version = 1, type_size = sizeof(Type), byte_order = 0x01020304, reserved = 0;
+    //byte_order reads differently on a machine with another byte order.
+    std::uint64_t num_nodes = 0, num_operands = 0, num_values = 0, root = 0;
+  };
+
+  /*!
+    \brief A node of a serialized runtime expression, with the same meaning as the members of `dynamic_node`,
+           except that `first` is the index of its first operand (in the operands)
+           or, for constants, the index of its value (in the values).
+  */
+  struct serialized_node
+  {
+    std::uint32_t kind = 0;
+    std::int32_t dim = 0, index = 0, num_cuts = 0;
+    std::int64_t num = 0, den = 1;
+    std::uint64_t first = 0;
+  };
+
+  namespace internals
+  {
+    /*!
+      \brief The alignment of each section of a serialized expression (and of the whole of it).
+    */
+    inline static constexpr std::size_t serialized_alignment = 16;
+
+    inline static constexpr std::size_t serialized_align(const std::size_t offset)
+    {
+      return (offset + serialized_alignment - 1) / serialized_alignment * serialized_alignment;
+    }
+
+    /*!
+      \brief The offsets of the nodes, the operands and the values, and the total size,
+             of a serialized expression with the sizes given in \p header.
+    */
+    struct serialized_layout
+    {
+      std::size_t nodes = 0, operands = 0, values = 0, size = 0;
+
+      explicit serialized_layout(const serialized_header& header)
+      {
+        nodes = serialized_align(sizeof(serialized_header));
+        operands = serialized_align(nodes + std::size_t(header.num_nodes) * sizeof(serialized_node));
+        values = serialized_align(operands + std::size_t(header.num_operands) * sizeof(std::uint64_t));
+        size = values + std::size_t(header.num_values) * sizeof(Type);
+      }
+    };
+
+    /*!
+      \brief Gathers the nodes of an expression in an order where the operands always come first.
+    */
+    class serialized_writer
+    {
+      public:
+
+      std::vector<serialized_node> nodes;
+      std::vector<std::uint64_t> operands;
+      std::vector<Type> values;
+
+      std::uint64_t add(const dynamic_node* f)
+      {
+        const auto found = m_indices.find(f);
+        if (found != m_indices.end())
+          {
+            return found->second;
+          }
+        std::vector<std::uint64_t> ops(std::size_t(f->num_operands()));
+        for (std::size_t i = 0; i < ops.size(); ++i)
+          {
+            ops[i] = add(f->operands[i]);
+          }
+        serialized_node node;
+        node.kind = std::uint32_t(f->kind);
+        node.dim = std::int32_t(f->dim);
+        node.index = std::int32_t(f->index);
+        node.num_cuts = std::int32_t(f->num_cuts);
+        node.num = f->exact.num;
+        node.den = f->exact.den;
+        if (f->kind == dynamic_kind::constant)
+          {
+            node.first = values.size();
+            values.push_back(f->value);
+          }
+        else
+          {
+            node.first = operands.size();
+            operands.insert(operands.end(), ops.begin(), ops.end());
+          }
+        nodes.push_back(node);
+        m_indices[f] = nodes.size() - 1;
+        return nodes.size() - 1;
+      }
+
+      private:
+
+      std::unordered_map<const dynamic_node*, std::uint64_t> m_indices;
+    };
+  }
+
+  /*!
+    \brief Gives a compact binary representation of the runtime expression \p f,
+           which can be read back in place by a `serialized_view` (for instance, after mapping a file to memory).
+
+    \details It is made of a `serialized_header`, the `serialized_node`s (each after its operands, so shared
+             subexpressions are only stored once), the indices of the operands and the values of the constants,
+             each section starting at a multiple of `internals::serialized_alignment` bytes.
+             The rationals are kept exactly and the constants bit for bit.
+
+    \remark The representation uses the byte order and the `Type` of the machine that wrote it,
+            which `serialized_view` checks as far as it can.
+  */
+  inline static std::vector<unsigned char> serialize(const dynamic_node* f)
+  {
+    static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable types can be serialized!");
+    static_assert(alignof(Type) <= internals::serialized_alignment, "The type is too strictly aligned to be serialized!");
+
+    internals::serialized_writer writer;
+    serialized_header header;
+    header.root = writer.add(f);
+    header.num_nodes = writer.nodes.size();
+    header.num_operands = writer.operands.size();
+    header.num_values = writer.values.size();
+
+    const internals::serialized_layout layout(header);
+    std::vector<unsigned char> ret(layout.size, 0);
+    std::memcpy(ret.data(), &header, sizeof(header));
+    std::memcpy(ret.data() + layout.nodes, writer.nodes.data(), writer.nodes.size() * sizeof(serialized_node));
+    std::memcpy(ret.data() + layout.operands, writer.operands.data(), writer.operands.size() * sizeof(std::uint64_t));
+    std::memcpy(ret.data() + layout.values, writer.values.data(), writer.values.size() * sizeof(Type));
+    return ret;
+  }
+
+  /*!
+    \brief Reads a serialized expression (see `serialize`) in place, without copying any of it.
+
+    \details The constructor checks the header, the sizes, that every node only refers to earlier ones
+             and that the cut-off points are numbers (in increasing order) or stored constants
+             (throwing `std::invalid_argument` otherwise), so the accessors need no further checks.
+
+    \pre \p data must be aligned to `internals::serialized_alignment` bytes (as memory from `new`
+         or from mapping a file is) and must outlive the view.
+  */
+  class serialized_view
+  {
+    public:
+
+    serialized_view(const void* data, const std::size_t size): m_data(static_cast<const unsigned char*>(data))
+    {
+      const serialized_header reference;
+      if (size < sizeof(serialized_header) || reinterpret_cast<std::uintptr_t>(data) % internals::serialized_alignment != 0)
+        {
+          throw std::invalid_argument("Not a properly aligned serialized expression!");
+        }
+      std::memcpy(&m_header, m_data, sizeof(serialized_header));
+      if (std::memcmp(m_header.magic, reference.magic, sizeof(reference.magic)) != 0 || m_header.version != reference.version)
+        {
+          throw std::invalid_argument("Not a serialized expression, or one from an unsupported version!");
+        }
+      if (m_header.byte_order != reference.byte_order)
+        {
+          throw std::invalid_argument("The serialized expression was written with a different byte order!");
+        }
+      if (m_header.type_size != reference.type_size)
+        {
+          throw std::invalid_argument("The serialized expression was written with a different number type!");
+        }
+      if (m_header.num_nodes == 0 || m_header.root >= m_header.num_nodes ||
+          m_header.num_nodes > size || m_header.num_operands > size || m_header.num_values > size ||
+          internals::serialized_layout(m_header).size > size)
+        {
+          throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+        }
+      const internals::serialized_layout layout(m_header);
+      m_nodes = reinterpret_cast<const serialized_node*>(m_data + layout.nodes);
+      m_operands = reinterpret_cast<const std::uint64_t*>(m_data + layout.operands);
+      m_values = reinterpret_cast<const Type*>(m_data + layout.values);
+      for (std::uint64_t i = 0; i < m_header.num_nodes; ++i)
+        {
+          check_node(i);
+        }
+    }
+
+    const serialized_header& header() const
+    {
+      return m_header;
+    }
+
+    std::size_t num_nodes() const
+    {
+      return std::size_t(m_header.num_nodes);
+    }
+
+    std::size_t root() const
+    {
+      return std::size_t(m_header.root);
+    }
+
+    const serialized_node& node(const std::size_t i) const
+    {
+      return m_nodes[i];
+    }
+
+    dynamic_kind kind(const std::size_t i) const
+    {
+      return dynamic_kind(m_nodes[i].kind);
+    }
+
+    /*!
+      \brief The index of the operand \p j of the node \p i.
+    */
+    std::size_t operand(const std::size_t i, const std::size_t j) const
+    {
+      return std::size_t(m_operands[m_nodes[i].first + j]);
+    }
+
+    /*!
+      \brief The values of the constants, read directly from the serialized data.
+    */
+    const Type* values() const
+    {
+      return m_values;
+    }
+
+    std::size_t num_values() const
+    {
+      return std::size_t(m_header.num_values);
+    }
+
+    /*!
+      \brief The numeric value of the node \p i, which must be a rational or a constant.
+    */
+    Type number(const std::size_t i) const
+    {
+      const serialized_node& n = m_nodes[i];
+      return (kind(i) == dynamic_kind::rational ? Type(n.num) / Type(n.den) : m_values[n.first]);
+    }
+
+    private:
+
+    const unsigned char* m_data = nullptr;
+    serialized_header m_header;
+    const serialized_node* m_nodes = nullptr;
+    const std::uint64_t* m_operands = nullptr;
+    const Type* m_values = nullptr;
+
+    void check_node(const std::uint64_t i) const
+    {
+      const serialized_node& n = m_nodes[i];
+      std::uint64_t num_ops = 0;
+      switch (n.kind)
+        {
+          case std::uint32_t(dynamic_kind::rational):
+            if (n.den <= 0)
+              {
+                throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+              }
+            return;
+          case std::uint32_t(dynamic_kind::constant):
+            if (n.first >= m_header.num_values)
+              {
+                throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+              }
+            return;
+          case std::uint32_t(dynamic_kind::stored):
+            if (n.index < 0)
+              {
+                throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+              }
+            return;
+          case std::uint32_t(dynamic_kind::monomial):
+            if (n.dim < 1 || n.dim > 64)
+              {
+                throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+              }
+            return;
+          case std::uint32_t(dynamic_kind::add):
+          case std::uint32_t(dynamic_kind::subtract):
+          case std::uint32_t(dynamic_kind::multiply):
+          case std::uint32_t(dynamic_kind::divide):
+            num_ops = 2;
+            break;
+          case std::uint32_t(dynamic_kind::piecewise):
+            if (n.dim < 1 || n.dim > 64 || n.num_cuts < 1)
+              {
+                throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+              }
+            num_ops = 2 * std::uint64_t(n.num_cuts) + 1;
+            break;
+          default:
+            throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+        }
+      if (n.first > m_header.num_operands || num_ops > m_header.num_operands - n.first)
+        {
+          throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+        }
+      for (std::uint64_t j = 0; j < num_ops; ++j)
+        {
+          if (m_operands[n.first + j] >= i)
+            {
+              throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+            }
+        }
+      if (n.kind == std::uint32_t(dynamic_kind::piecewise))
+        {
+          check_cuts(i);
+        }
+    }
+
+    void check_cuts(const std::uint64_t i) const
+    //As in dynamic_arena::piecewise, the cut-off points must be numbers or stored constants,
+    //and those that are numbers must be increasing (which is what evaluate_serialized relies on).
+    {
+      const std::size_t num_cuts = std::size_t(m_nodes[i].num_cuts);
+      std::size_t last_number = 0;
+      bool has_number = false;
+      for (std::size_t k = 0; k < num_cuts; ++k)
+        {
+          const std::size_t cut = operand(std::size_t(i), num_cuts + 1 + k);
+          const dynamic_kind cut_kind = kind(cut);
+          if (cut_kind == dynamic_kind::stored)
+            {
+              continue;
+            }
+          if (cut_kind != dynamic_kind::rational && cut_kind != dynamic_kind::constant)
+            {
+              throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+            }
+          if (has_number && !is_less(last_number, cut))
+            {
+              throw std::invalid_argument("The serialized expression is truncated or corrupted!");
+            }
+          last_number = cut;
+          has_number = true;
+        }
+    }
+
+    bool is_less(const std::size_t a, const std::size_t b) const
+    //For two numeric nodes, exactly if both are rationals (and their difference fits).
+    {
+      if (kind(a) == dynamic_kind::rational && kind(b) == dynamic_kind::rational)
+        {
+          const internals::wide_rational difference = internals::wide_rational(m_nodes[b].num, m_nodes[b].den) -
+                                                      internals::wide_rational(m_nodes[a].num, m_nodes[a].den);
+          if (!difference.overflow)
+            {
+              return difference.sign() > 0;
+            }
+        }
+      return number(a) < number(b);
+    }
+  };
+
+  /*!
+    \brief Evaluates the node \p i of \p view at \p point, with the same semantics
+           as `evaluate_dynamic`, reading everything directly from the serialized data.
+  */
+  inline static Type evaluate_serialized(const serialized_view& view, const std::size_t i, const Type* point, const Type* parameters)
+  {
+    const serialized_node& n = view.node(i);
+    switch (view.kind(i))
+      {
+        case dynamic_kind::rational:
+        case dynamic_kind::constant:
+          return view.number(i);
+        case dynamic_kind::stored:
+          if (parameters == nullptr)
+            {
+              throw std::invalid_argument("Stored constants need parameters to be evaluated!");
+            }
+          return parameters[n.index];
+        case dynamic_kind::monomial:
+          return fastpow(point[n.dim - 1], n.index);
+        case dynamic_kind::add:
+          return evaluate_serialized(view, view.operand(i, 0), point, parameters) + evaluate_serialized(view, view.operand(i, 1), point, parameters);
+        case dynamic_kind::subtract:
+          return evaluate_serialized(view, view.operand(i, 0), point, parameters) - evaluate_serialized(view, view.operand(i, 1), point, parameters);
+        case dynamic_kind::multiply:
+          return evaluate_serialized(view, view.operand(i, 0), point, parameters) * evaluate_serialized(view, view.operand(i, 1), point, parameters);
+        case dynamic_kind::divide:
+          return evaluate_serialized(view, view.operand(i, 0), point, parameters) / evaluate_serialized(view, view.operand(i, 1), point, parameters);
+        default:
+          {
+            const Type x = point[n.dim - 1];
+            for (std::size_t k = 0; k < std::size_t(n.num_cuts); ++k)
+              {
+                const Type cut = evaluate_serialized(view, view.operand(i, std::size_t(n.num_cuts) + 1 + k), point, parameters);
+                if (x < cut)
+                  {
+                    return evaluate_serialized(view, view.operand(i, k), point, parameters);
+                  }
+                else if (x == cut)
+                  {
+                    return (evaluate_serialized(view, view.operand(i, k), point, parameters) +
+                            evaluate_serialized(view, view.operand(i, k + 1), point, parameters)) / Type(2);
+                  }
+              }
+            return evaluate_serialized(view, view.operand(i, std::size_t(n.num_cuts)), point, parameters);
+          }
+      }
+  }
+
+  /*!
+    \brief Same as above, for the root of \p view.
+  */
+  inline static Type evaluate_serialized(const serialized_view& view, const Type* point, const Type* parameters = nullptr)
+  {
+    return evaluate_serialized(view, view.root(), point, parameters);
+  }
+
+  /*!
+    \brief Builds in \p arena the runtime expression serialized in \p view,
+           so that it can be transformed (or compiled with `compile_program`) again.
+  */
+  inline static const dynamic_node* deserialize(const serialized_view& view, dynamic_arena& arena)
+  {
+    std::vector<const dynamic_node*> built(view.num_nodes(), nullptr);
+    for (std::size_t i = 0; i < view.num_nodes(); ++i)
+      {
+        const serialized_node& n = view.node(i);
+        const auto op = [&](const std::size_t j) { return built[view.operand(i, j)]; };
+        switch (view.kind(i))
+          {
+            case dynamic_kind::rational:
+              built[i] = arena.rational(n.num, n.den);
+              break;
+            case dynamic_kind::constant:
+              built[i] = arena.constant(view.number(i));
+              break;
+            case dynamic_kind::stored:
+              built[i] = arena.stored(n.index);
+              break;
+            case dynamic_kind::monomial:
+              built[i] = arena.monomial(n.index, n.dim);
+              break;
+            case dynamic_kind::add:
+              built[i] = arena.add(op(0), op(1));
+              break;
+            case dynamic_kind::subtract:
+              built[i] = arena.subtract(op(0), op(1));
+              break;
+            case dynamic_kind::multiply:
+              built[i] = arena.multiply(op(0), op(1));
+              break;
+            case dynamic_kind::divide:
+              built[i] = arena.divide(op(0), op(1));
+              break;
+            default:
+              {
+                std::vector<const dynamic_node*> cuts, pieces;
+                for (std::size_t k = 0; k <= std::size_t(n.num_cuts); ++k)
+                  {
+                    pieces.push_back(op(k));
+                  }
+                for (std::size_t k = 0; k < std::size_t(n.num_cuts); ++k)
+                  {
+                    cuts.push_back(op(std::size_t(n.num_cuts) + 1 + k));
+                  }
+                built[i] = arena.piecewise(n.dim, cuts, pieces);
+                break;
+              }
+          }
+      }
+    return built[view.root()];
+  }
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef SIMBPOLIC_TABULATE
+#define SIMBPOLIC_TABULATE
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    /*!
+      \brief The largest number of table entries times nodes of the expression (see `expression_size`) `tabulate` accepts,
+             to keep compile-time evaluation well within the limits of the compilers on the number of evaluation steps.
+    */
+    inline static constexpr long long tabulate_budget = 1 << 18;
+
+    template <class StartT, class EndT>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static Type tabulate_point(const StartT& start, const EndT& end,
+                                                                       const std::size_t i, const std::size_t N)
+    //The point i of N equally spaced ones from start to end, computed exactly when both ends are exact
+    //(in the checked wide arithmetic, falling back to the numeric interpolation if even that overflows).
+    {
+      if (N == 1)
+        {
+          return Type(start);
+        }
+      if constexpr (is_exact<StartT> && is_exact<EndT>)
+        {
+          const exact_fraction a = exact_value_of(start), b = exact_value_of(end);
+          const wide_rational point = (wide_rational(a.num, a.den) * wide_rational(wide_indexer(N - 1 - i)) +
+                                       wide_rational(b.num, b.den) * wide_rational(wide_indexer(i))) / wide_rational(wide_indexer(N - 1));
+          if (!point.overflow)
+            {
+              return Type(point.num) / Type(point.den);
+            }
+        }
+      const Type a = Type(start), b = Type(end);
+      return (a * Type(N - 1 - i) + b * Type(i)) / Type(N - 1);
+    }
+  }
+
+  /*!
+    \brief Gives the values of \p f (with the value of the dimension \p dim) at \p N equally spaced points
+           from \p start to \p end (both included), as an array that can be computed at compile-time.
+
+    \details When \p f, \p start and \p end are constant expressions (as functions with only exact coefficients
+             and exact limits are), `constexpr auto table = tabulate<N>(f, var, start, end);` is computed
+             entirely by the compiler and placed in read-only data, with no cost at startup.
+             When both limits are exact, each point is computed exactly (in `internals::wide_rational`) and only rounded once,
+             unless even that overflows, in which case it is interpolated numerically.
+             At the cut-off points, the average of both sides is taken, as usual.
+
+    \pre \p f may only depend on \p dim and may not have `Stored` constants.
+  */
+  template <std::size_t N, class Func, indexer dim, class StartT, class EndT>
+  SIMBPOLIC_CUDA_HOS_DEV constexpr inline static std::array<Type, N> tabulate(const Func& f, const Var<dim>& var,
+                                                                             const StartT& start, const EndT& end)
+  {
+    static_assert(N > 0, "The table must have at least one entry!");
+    static_assert(internals::integrates_all_dimensions<Func, 1, Var<dim>>(), "The function may only depend on the given dimension!");
+    static_assert(stored_count<Func> == 0, "Stored constants need a store to be evaluated!");
+    static_assert((long long) N * expression_size<Func> <= internals::tabulate_budget,
+                  "The table is too large to be reliably computed at compile-time!");
+    std::array<Type, N> ret {};
+    for (std::size_t i = 0; i < N; ++i)
+      {
+        Type point[dim] {};
+        point[dim - 1] = internals::tabulate_point(start, end, i, N);
+        ret[i] = internals::evaluate_with(f, point);
+      }
+    return ret;
+  }
+}
+
+#endif
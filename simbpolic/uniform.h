@@ -0,0 +1,181 @@
+#ifndef SIMBPOLIC_UNIFORM
+#define SIMBPOLIC_UNIFORM
+
+namespace Simbpolic
+{
+  namespace internals
+  {
+    /*!
+      \brief The number of consecutive points evaluated by forward differencing
+             before the table of differences is computed again from the polynomial,
+             so that rounding errors do not keep accumulating.
+    */
+    inline static constexpr std::size_t uniform_reanchor_period = 64;
+
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static bool uniform_inside(const Type& x, const bool has_lower, const Type& lower,
+                                                                       const bool has_upper, const Type& upper)
+    {
+      return (!has_lower || x > lower) && (!has_upper || x < upper);
+    }
+
+    /*!
+      \brief Gives the first index `j` (from \p begin up to \p N) for which `x0 + j * h` is not strictly between
+             the cut-off points that surround `x0 + begin * h` (the ones that exist, as given by \p has_lower and \p has_upper).
+    */
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static std::size_t uniform_segment_end(const Type& x0, const Type& h, const std::size_t begin,
+                                                                                const std::size_t N, const bool has_lower, const Type& lower,
+                                                                                const bool has_upper, const Type& upper)
+    {
+      //The points move monotonically, so the first one outside can be found by bisection.
+      std::size_t low = begin + 1, high = N;
+      while (low < high)
+        {
+          const std::size_t middle = low + (high - low) / 2;
+          if (uniform_inside(x0 + Type(middle) * h, has_lower, lower, has_upper, upper))
+            {
+              low = middle + 1;
+            }
+          else
+            {
+              high = middle;
+            }
+        }
+      return low;
+    }
+
+    template <indexer n, indexer k = 0>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void step_differences(Type* diffs)
+    //Advances the table of forward differences by one step (unrolled at compile-time).
+    {
+      if constexpr (k < n)
+        {
+          diffs[k] = diffs[k] + diffs[k + 1];
+          step_differences<n, k + 1>(diffs);
+        }
+    }
+
+    /*!
+      \brief Writes `p(t_0 + k * h)` to `out[k]` for `k` from `0` to `count - 1`,
+             using a table of forward differences that is re-seeded every `uniform_reanchor_period` points.
+
+      \remark The differences are computed from the coefficients of the polynomial
+              (shifted to the start of each block and scaled by the powers of \p h),
+              as `Delta^k = sum_m b_m * k! * S(m, k)` with `S` the Stirling numbers of the second kind,
+              instead of by subtracting nearby values, which would lose most of the significant digits.
+    */
+    template <class Poly>
+    SIMBPOLIC_CUDA_HOS_DEV constexpr inline static void forward_differences(const Poly& p, const Type& t_0, const Type& h,
+                                                                            const std::size_t count, Type* out)
+    {
+      constexpr indexer n = Poly::degree[0];
+      Type diffs[n + 1] {}, coeffs[n + 1] {}, stirling[n + 1] {};
+      for (std::size_t start = 0; start < count; start += uniform_reanchor_period)
+        {
+          const std::size_t stop = (count - start > uniform_reanchor_period ? start + uniform_reanchor_period : count);
+          const Type anchor = t_0 + Type(start) * h;
+          for (indexer m = 0; m <= n; ++m)
+            {
+              coeffs[m] = p.coefficients[m];
+              diffs[m] = Type(0);
+              stirling[m] = Type(0);
+            }
+          for (indexer i = 0; i < n; ++i)
+            {
+              for (indexer j = n - 1; j >= i; --j)
+                {
+                  coeffs[j] = coeffs[j] + anchor * coeffs[j + 1];
+                }
+            }
+          //stirling[k] holds k! * S(m, k) for the current m.
+          Type power = Type(1);
+          stirling[0] = Type(1);
+          for (indexer m = 0; m <= n; ++m)
+            {
+              if (m > 0)
+                {
+                  power = power * h;
+                  for (indexer k = m; k > 0; --k)
+                    {
+                      stirling[k] = Type(k) * (stirling[k] + stirling[k - 1]);
+                    }
+                  stirling[0] = Type(0);
+                }
+              const Type b = coeffs[m] * power;
+              for (indexer k = 0; k <= m; ++k)
+                {
+                  diffs[k] = diffs[k] + b * stirling[k];
+                }
+            }
+          for (std::size_t j = start; j < stop; ++j)
+            {
+              out[j] = diffs[0];
+              step_differences<n>(diffs);
+            }
+        }
+    }
+  }
+
+  /*!
+    \brief Writes `f(x0 + i * h)` to `out[i]` (with the value of the dimension \p dim),
+           for `i` from 0 to `N - 1`.
+
+    \details Each polynomial piece of \p f along \p dim is expanded once (by evaluating \p f
+             with polynomials instead of numbers, anchored at the first point of the piece),
+             and then stepped through by forward differencing, so that each point only costs
+             as many additions as the degree of \p f.
+             The differences are seeded again whenever a cut-off point is crossed,
+             and every `internals::uniform_reanchor_period` points to bound the drift.
+             Points that lie exactly at a cut-off point are evaluated directly
+             (giving the average of both sides, as usual).
+
+    \pre \p f may only depend on \p dim, must be a polynomial along it (in each of its pieces)
+         and may not have cut-off points given by `Stored` constants.
+  */
+  template <class Func, indexer dim>
+  SIMBPOLIC_CUDA_HOS_DEV inline static void evaluate_uniform(const Func& f, const Var<dim>& var, const Type& x0, const Type& h,
+                                                             const std::size_t N, Type* out)
+  {
+    static_assert(internals::integrates_all_dimensions<Func, 1, Var<dim>>(), "The function may only depend on the given dimension!");
+    static_assert(polynomial_degree<Func, dim> >= 0, "The function must be a polynomial along the given dimension!");
+    static_assert(stored_count<Func> == 0, "Stored constants need a store to be evaluated!");
+
+    using poly_type = dense_polynomial<1, polynomial_degree<Func, dim>>;
+
+    Type cuts[cut_count<Func, dim> + 1] {};
+    const indexer num_cuts = internals::sorted_cuts<dim>(f, cuts);
+
+    std::size_t i = 0;
+    while (i < N)
+      {
+        const Type x = x0 + Type(i) * h;
+        indexer piece = 0;
+        while (piece < num_cuts && cuts[piece] < x)
+          {
+            ++piece;
+          }
+        if (piece < num_cuts && cuts[piece] == x)
+          {
+            Type point[dim] {};
+            point[dim - 1] = x;
+            out[i++] = internals::evaluate_with(f, point);
+            continue;
+          }
+
+        const std::size_t end = internals::uniform_segment_end(x0, h, i, N,
+                                                               piece > 0, cuts[piece > 0 ? piece - 1 : 0],
+                                                               piece < num_cuts, cuts[piece < num_cuts ? piece : 0]);
+
+        poly_type point[dim] {};
+        point[dim - 1] = poly_type::variable(0);
+        point[dim - 1].coefficients[0] = x;
+        //Since the value of the variable is x, this picks the piece that contains it,
+        //expanded in powers of (x_dim - x).
+        const poly_type p = internals::evaluate_with(f, point);
+
+        internals::forward_differences(p, Type(0), h, end - i, out + i);
+        i = end;
+      }
+  }
+}
+
+#endif
@@ -0,0 +1,193 @@
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#include "simbpolic/any_function.h"
+#include "check.h"
+
+//An any_function must behave the same whether its function is kept inside it, allocated or borrowed,
+//through copies, moves and assignments between them, and its batches must match eval and integrate.
+
+static int allocations = 0, deallocations = 0;
+
+void* operator new (std::size_t size)
+{
+  ++allocations;
+  void* ret = std::malloc(size == 0 ? 1 : size);
+  if (ret == nullptr)
+    {
+      throw std::bad_alloc{};
+    }
+  return ret;
+}
+
+void operator delete (void* p) noexcept
+{
+  if (p != nullptr)
+    {
+      ++deallocations;
+    }
+  std::free(p);
+}
+
+void operator delete (void* p, std::size_t) noexcept
+{
+  if (p != nullptr)
+    {
+      ++deallocations;
+    }
+  std::free(p);
+}
+
+using namespace Simbpolic;
+
+constexpr std::size_t n = 4;
+const Type xs[n] = {-1.5, -0.25, 0.5, 2.};
+const Type ys[n] = {0.5, 1., -2., 0.75};
+const Type* const coordinates[2] = {xs, ys};
+
+template <class Func>
+void check_values(const any_function& held, const Func& f)
+{
+  Type results[n] {};
+  held.evaluate(coordinates, n, results);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      SIMBPOLIC_CHECK_CLOSE(results[i], eval(f, xs[i], ys[i]));
+    }
+}
+
+const Monomial<1, 1> x;
+const Monomial<1, 2> y;
+const auto small = x * x * y - Intg<3>{} * y;
+const auto large = branched(Var<1>{}, Constant{0.5} * x * y + Constant{1.5}, Intg<-1>{}, Constant{2.} * x - Constant{0.25} * y * y,
+                            One{}, Constant{-3.} * x * x * y + Constant{0.125});
+const auto borrowed_model = internals::make_any_function_model(x + Intg<2>{} * y);
+
+int main()
+{
+  {
+    const int before = allocations;
+    const any_function local(small), heap(large), borrowed = any_function::referring_to(borrowed_model);
+    SIMBPOLIC_CHECK(local.is_local() && !heap.is_local() && !borrowed.is_local());
+    SIMBPOLIC_CHECK(allocations == before + 1);
+    check_values(local, small);
+    check_values(heap, large);
+    check_values(borrowed, x + Intg<2>{} * y);
+
+    //Copies: only the allocated function is allocated again.
+    any_function local_copy(local), heap_copy(heap), borrowed_copy(borrowed);
+    SIMBPOLIC_CHECK(allocations == before + 2);
+    SIMBPOLIC_CHECK(local_copy.is_local() && !heap_copy.is_local() && !borrowed_copy.is_local());
+    check_values(local_copy, small);
+    check_values(heap_copy, large);
+    check_values(borrowed_copy, x + Intg<2>{} * y);
+
+    //Moves: nothing is allocated, and the moved-from objects are left empty.
+    any_function local_moved(std::move(local_copy)), heap_moved(std::move(heap_copy)), borrowed_moved(std::move(borrowed_copy));
+    SIMBPOLIC_CHECK(allocations == before + 2);
+    SIMBPOLIC_CHECK(local_copy.empty() && heap_copy.empty() && borrowed_copy.empty());
+    SIMBPOLIC_CHECK(local_moved.is_local() && !heap_moved.is_local());
+    check_values(local_moved, small);
+    check_values(heap_moved, large);
+    check_values(borrowed_moved, x + Intg<2>{} * y);
+
+    //Assignments between all of the kinds.
+    local_moved = heap;
+    check_values(local_moved, large);
+    SIMBPOLIC_CHECK(!local_moved.is_local());
+    heap_moved = local;
+    check_values(heap_moved, small);
+    SIMBPOLIC_CHECK(heap_moved.is_local());
+    borrowed_moved = std::move(heap_moved);
+    check_values(borrowed_moved, small);
+    SIMBPOLIC_CHECK(heap_moved.empty());
+    heap_moved = borrowed;
+    check_values(heap_moved, x + Intg<2>{} * y);
+    local_copy = std::move(local_moved);
+    check_values(local_copy, large);
+    const any_function& self = local_copy;
+    local_copy = self;
+    check_values(local_copy, large);
+    local_copy = std::move(local_copy);
+    check_values(local_copy, large);
+  }
+  //Everything that was allocated has been freed.
+  SIMBPOLIC_CHECK(allocations == deallocations);
+
+  //Batches of derivatives and integrals.
+  const any_function held(large);
+  const Type starts[n] = {-2., -0.5, 1.5, 0.}, ends[n] = {2., 0.5, -1., 0.};
+  Type results[n] {};
+  held.derivative(1, coordinates, n, results);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      SIMBPOLIC_CHECK_CLOSE(results[i], eval(large.derivative<1>(), xs[i], ys[i]));
+    }
+  held.derivative(2, coordinates, n, results);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      SIMBPOLIC_CHECK_CLOSE(results[i], eval(large.derivative<2>(), xs[i], ys[i]));
+    }
+  held.derivative(3, coordinates, n, results);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      SIMBPOLIC_CHECK(results[i] == 0.);
+    }
+  //The same limits for every point, since the symbolic integral across the cut-off points needs them to be exact.
+  const Type lower[n] = {-2., -2., -2., -2.}, upper[n] = {1.5, 1.5, 1.5, 1.5};
+  held.integrate(1, lower, upper, coordinates, n, results);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      SIMBPOLIC_CHECK_CLOSE(results[i], eval(integrate(large, Var<1>{}, Intg<-2>{}, Rational<3, 2>{}), xs[i], ys[i]));
+    }
+  held.integrate(2, starts, ends, coordinates, n, results);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      SIMBPOLIC_CHECK_CLOSE(results[i], eval(integrate(large, Var<2>{}, Constant{starts[i]}, Constant{ends[i]}), xs[i], ys[i]));
+    }
+  held.integrate(3, starts, ends, coordinates, n, results);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      SIMBPOLIC_CHECK_CLOSE(results[i], eval(large, xs[i], ys[i]) * (ends[i] - starts[i]));
+    }
+
+  //The errors.
+  const any_function rational(y / x);
+  bool thrown = false;
+  try
+    {
+      rational.integrate(1, starts, ends, coordinates, n, results);
+    }
+  catch (const std::domain_error&)
+    {
+      thrown = true;
+    }
+  SIMBPOLIC_CHECK(thrown);
+  rational.integrate(2, starts, ends, coordinates, n, results);
+  SIMBPOLIC_CHECK_CLOSE(results[0], (ends[0] * ends[0] - starts[0] * starts[0]) / 2. / xs[0]);
+
+  thrown = false;
+  try
+    {
+      any_function{}.evaluate(coordinates, n, results);
+    }
+  catch (const std::logic_error&)
+    {
+      thrown = true;
+    }
+  SIMBPOLIC_CHECK(thrown);
+
+  thrown = false;
+  try
+    {
+      any_function(Stored<0>{} * x).evaluate(coordinates, n, results);
+    }
+  catch (const std::invalid_argument&)
+    {
+      thrown = true;
+    }
+  SIMBPOLIC_CHECK(thrown);
+
+  return check_failures;
+}
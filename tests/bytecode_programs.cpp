@@ -0,0 +1,77 @@
+#include <vector>
+
+#include "simbpolic/bytecode.h"
+#include "check.h"
+
+//Compiled programs must give the same values as evaluating the runtime expressions directly,
+//also on the heavily shared expressions the arena builds, and in blocks that are not full.
+
+using namespace Simbpolic;
+
+void check_program(const dynamic_node* f, const std::vector<Type>& xs, const std::vector<Type>& ys)
+{
+  const dynamic_program program = compile_program(f);
+  const Type* coordinates[2] = {xs.data(), ys.data()};
+  std::vector<Type> results(xs.size());
+  evaluate_program(program, coordinates, xs.size(), results.data());
+  for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+      const Type point[2] = {xs[i], ys[i]};
+      SIMBPOLIC_CHECK_CLOSE(results[i], evaluate_dynamic(f, point));
+    }
+}
+
+int main()
+{
+  dynamic_arena arena;
+  const auto x = arena.variable(1);
+  const auto y = arena.variable(2);
+
+  //Each level refers to the previous one twice, so, as a tree, level k would have 2^k leaves;
+  //the value of level k is x^2 - 3 x - (1 + 1/2 + ... + 1/k) / 2.
+  std::vector<const dynamic_node*> levels {arena.subtract(arena.multiply(x, x), arena.multiply(arena.rational(3), x))};
+  for (int k = 1; k <= 64; ++k)
+    {
+      const auto previous = levels.back();
+      levels.push_back(arena.add(arena.multiply(arena.rational(1, 2), previous),
+                                 arena.multiply(arena.rational(1, 2), arena.subtract(previous, arena.rational(1, k)))));
+    }
+
+  //Not a multiple of the block size, going through the cut-off points below.
+  const std::size_t count = 3 * internals::program_block_size + 37;
+  std::vector<Type> xs(count), ys(count);
+  for (std::size_t i = 0; i < count; ++i)
+    {
+      xs[i] = -2. + Type(i) / 160.;
+      ys[i] = 1.5 - Type(i % 17) / 8.;
+    }
+
+  //Too large to be evaluated directly, but compiled in linear time.
+  const dynamic_program deep = compile_program(levels[64]);
+  SIMBPOLIC_CHECK(deep.code.size() == 1);
+  const Type* coordinates[1] = {xs.data()};
+  std::vector<Type> results(count);
+  evaluate_program(deep, coordinates, count, results.data());
+  Type harmonic = 0.;
+  for (int k = 1; k <= 64; ++k)
+    {
+      harmonic += 1. / k;
+    }
+  for (std::size_t i = 0; i < count; ++i)
+    {
+      SIMBPOLIC_CHECK_CLOSE(results[i], xs[i] * xs[i] - 3. * xs[i] - harmonic / 2.);
+    }
+
+  const auto shared = levels[10];
+  check_program(shared, xs, ys);
+  check_program(arena.multiply(shared, y), xs, ys);
+  check_program(arena.derivative(shared, 1), xs, ys);
+  check_program(arena.primitive(arena.multiply(shared, arena.add(shared, y)), 1), xs, ys);
+
+  const auto piecewise = arena.piecewise(1, {arena.rational(-1), arena.rational(1, 2), arena.constant(2.)},
+                                         {arena.rational(0), arena.multiply(shared, y), shared, arena.constant(2.5)});
+  check_program(piecewise, xs, ys);
+  check_program(arena.add(piecewise, arena.multiply(piecewise, shared)), xs, ys);
+
+  return check_failures;
+}
@@ -0,0 +1,36 @@
+#ifndef SIMBPOLIC_TESTS_CHECK
+#define SIMBPOLIC_TESTS_CHECK
+
+#include <cmath>
+#include <iostream>
+
+//Minimal checks for the tests: each failure is reported and counted,
+//and the test returns the number of failures.
+
+inline static int check_failures = 0;
+
+#define SIMBPOLIC_CHECK(COND)                                                          \
+  do                                                                                   \
+    {                                                                                  \
+      if (!(COND))                                                                     \
+        {                                                                              \
+          std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #COND "\n";   \
+          ++check_failures;                                                            \
+        }                                                                              \
+    }                                                                                  \
+  while (false)
+
+#define SIMBPOLIC_CHECK_CLOSE(A, B)                                                    \
+  do                                                                                   \
+    {                                                                                  \
+      const double check_a = double(A), check_b = double(B);                          \
+      if (!(std::abs(check_a - check_b) <= 1e-12 * (1 + std::abs(check_b))))           \
+        {                                                                              \
+          std::cerr << __FILE__ << ":" << __LINE__ << ": " #A " = " << check_a         \
+                    << " differs from " #B " = " << check_b << "\n";                   \
+          ++check_failures;                                                            \
+        }                                                                              \
+    }                                                                                  \
+  while (false)
+
+#endif
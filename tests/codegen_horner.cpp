@@ -0,0 +1,40 @@
+#include <limits>
+#include <string>
+
+#include "simbpolic/codegen.h"
+#include "check.h"
+
+//The polynomials are emitted in Horner form without the zero coefficients,
+//and non-finite constants, which have no literals, are rejected.
+
+using namespace Simbpolic;
+
+static std::string returned(const std::string& source)
+{
+  const std::size_t start = source.find("return ") + 7;
+  return source.substr(start, source.find(";\n", start) - start);
+}
+
+int main()
+{
+  const Monomial<1, 1> x;
+
+  SIMBPOLIC_CHECK(returned(generate_source(Rational<1, 3>{} * (x ^ Intg<3>{}), "f")) ==
+                  "((x[0] * x[0] * x[0]) * 0x1.5555555555555p-2)");
+  SIMBPOLIC_CHECK(returned(generate_source(x * x * x * x - Intg<2>{} * x * x + Intg<3>{}, "f")) ==
+                  "(0x1.8p+1 + x[0] * (x[0] * ((-0x1p+1) + x[0] * (x[0]))))");
+  SIMBPOLIC_CHECK(generate_source(x * x * x * x * x + Rational<1, 2>{} * x * x, "f").find("0x0p+0") == std::string::npos);
+
+  bool thrown = false;
+  try
+    {
+      generate_source(x * Constant{std::numeric_limits<Type>::infinity()}, "f");
+    }
+  catch (const std::domain_error&)
+    {
+      thrown = true;
+    }
+  SIMBPOLIC_CHECK(thrown);
+
+  return check_failures;
+}
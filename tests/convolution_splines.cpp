@@ -0,0 +1,67 @@
+#include "simbpolic.h"
+
+//Convolving boxes must give the exact B-spline kernels: all the checks are done at compile-time,
+//on the exact piecewise representations of the results.
+
+using namespace Simbpolic;
+
+template <indexer C1, indexer D1, indexer C2, indexer D2>
+constexpr bool same_pieces(const internals::exact_piecewise<C1, D1>& a, const internals::exact_piecewise<C2, D2>& b)
+{
+  if (a.num_cuts != b.num_cuts)
+    {
+      return false;
+    }
+  for (indexer i = 0; i < a.num_cuts; ++i)
+    {
+      if (!(a.cuts[i] == b.cuts[i]))
+        {
+          return false;
+        }
+    }
+  constexpr indexer D = (D1 > D2 ? D1 : D2);
+  for (indexer i = 0; i <= a.num_cuts; ++i)
+    {
+      for (indexer k = 0; k <= D; ++k)
+        {
+          const internals::exact_fraction c_a = (k <= D1 ? a.coefficients[i][k] : internals::exact_fraction(0));
+          const internals::exact_fraction c_b = (k <= D2 ? b.coefficients[i][k] : internals::exact_fraction(0));
+          if (!(c_a == c_b))
+            {
+              return false;
+            }
+        }
+    }
+  return true;
+}
+
+template <class F, class G>
+constexpr bool same_function()
+{
+  return same_pieces(internals::exact_piecewise_of<std::decay_t<F>, 1>::value, internals::exact_piecewise_of<std::decay_t<G>, 1>::value);
+}
+
+constexpr Monomial<1, 1> x {};
+
+constexpr auto box = branched(Var<1>{}, Zero{}, Rational<-1, 2>{}, One{}, Rational<1, 2>{}, Zero{});
+
+constexpr auto tent = branched(Var<1>{}, Zero{}, Intg<-1>{}, x + One{}, Zero{}, One{} - x, One{}, Zero{});
+
+constexpr auto quadratic_spline = branched(Var<1>{}, Zero{},
+                                           Rational<-3, 2>{}, Rational<1, 2>{} * (x + Rational<3, 2>{}) * (x + Rational<3, 2>{}),
+                                           Rational<-1, 2>{}, Rational<3, 4>{} - x * x,
+                                           Rational<1, 2>{}, Rational<1, 2>{} * (Rational<3, 2>{} - x) * (Rational<3, 2>{} - x),
+                                           Rational<3, 2>{}, Zero{});
+
+constexpr auto box_box = convolve(box, box, Var<1>{});
+constexpr auto box_box_box = convolve(box_box, box, Var<1>{});
+
+static_assert(same_function<decltype(box_box), decltype(tent)>());
+static_assert(same_function<decltype(box_box_box), decltype(quadratic_spline)>());
+static_assert(same_function<decltype(convolve(box, box_box, Var<1>{})), decltype(quadratic_spline)>());
+static_assert(!same_function<decltype(box_box), decltype(box)>());
+
+int main()
+{
+  return 0;
+}
@@ -0,0 +1,30 @@
+#include "simbpolic/dynamic.h"
+#include "check.h"
+
+//The runtime expressions do their rational arithmetic exactly while it fits,
+//and fall back to constants (rather than overflowing) when it does not.
+
+using namespace Simbpolic;
+
+int main()
+{
+  dynamic_arena arena;
+  const double origin[1] = {0.};
+
+  const auto small = arena.integrate(arena.monomial(8, 1), 1, arena.rational(0), arena.rational(3, 7));
+  SIMBPOLIC_CHECK(small->kind == dynamic_kind::rational);
+  SIMBPOLIC_CHECK_CLOSE(evaluate_dynamic(small, origin),
+                        Type(integrate(Monomial<8, 1>{}, Var<1>{}, Zero{}, Rational<3, 7>{})));
+
+  const auto large = arena.integrate(arena.monomial(30, 1), 1, arena.rational(0), arena.rational(3, 7));
+  SIMBPOLIC_CHECK_CLOSE(evaluate_dynamic(large, origin), std::pow(3. / 7., 31) / 31.);
+
+  const auto sum = arena.add(arena.rational(1, 3037000493LL), arena.rational(1, 3037000453LL));
+  SIMBPOLIC_CHECK_CLOSE(evaluate_dynamic(sum, origin), 1. / 3037000493. + 1. / 3037000453.);
+
+  const auto big = arena.rational(4000000000000000000LL);
+  SIMBPOLIC_CHECK_CLOSE(evaluate_dynamic(arena.multiply(big, big), origin), 1.6e37);
+  SIMBPOLIC_CHECK(evaluate_dynamic(arena.subtract(arena.multiply(big, big), arena.multiply(big, big)), origin) == 0.);
+
+  return check_failures;
+}
@@ -0,0 +1,51 @@
+#include <type_traits>
+
+#include "simbpolic.h"
+
+//Integrals with exact coefficients, cut-off points and limits, along all of the dimensions of the integrand,
+//must collapse to a single exact number: all the checks are done at compile-time.
+
+using namespace Simbpolic;
+
+template <class Expected, class Integral>
+constexpr bool is_exactly()
+{
+  return std::is_same_v<std::decay_t<Integral>, Expected>;
+}
+
+constexpr Monomial<1, 1> x {};
+constexpr Monomial<1, 2> y {};
+constexpr Monomial<1, 3> z {};
+
+//Polynomials.
+static_assert(is_exactly<Rational<1, 3>, decltype(integrate(x * x, Var<1>{}, Zero{}, One{}))>());
+static_assert(is_exactly<Rational<-4, 3>, decltype(integrate(x * x - Intg<2>{} * x, Var<1>{}, Zero{}, Intg<2>{}))>());
+static_assert(is_exactly<Rational<5, 3>, decltype(integrate(x * y + x * x, Var<1>{}, Zero{}, One{}, Var<2>{}, Zero{}, Intg<2>{}))>());
+static_assert(is_exactly<Rational<1, 8>, decltype(integrate(x * y * z, Var<1>{}, Zero{}, One{}, Var<2>{}, Zero{}, One{},
+                                                            Var<3>{}, Zero{}, One{}))>());
+static_assert(is_exactly<Rational<1, 2>, decltype(integrate(One{}, Var<2>{}, Zero{}, x, Var<1>{}, Zero{}, One{}))>());
+static_assert(is_exactly<Zero, decltype(integrate(x, Var<1>{}, Intg<-1>{}, One{}))>());
+
+//Branched functions.
+constexpr auto tent = branched(Var<1>{}, Zero{}, Intg<-1>{}, x + One{}, Zero{}, One{} - x, One{}, Zero{});
+static_assert(is_exactly<One, decltype(integrate(tent, Var<1>{}, Intg<-2>{}, Intg<2>{}))>());
+static_assert(is_exactly<Rational<7, 8>, decltype(integrate(tent, Var<1>{}, Rational<-1, 2>{}, Intg<3>{}))>());
+static_assert(is_exactly<Rational<5, 3>, decltype(integrate(tent * (x + Intg<2>{}), Var<1>{}, Intg<-2>{}, Rational<1, 2>{}))>());
+static_assert(is_exactly<Rational<3, 2>, decltype(integrate(tent * y, Var<1>{}, Intg<-1>{}, One{}, Var<2>{}, One{}, Intg<2>{}))>());
+
+//Products that need integration by parts.
+constexpr auto cube = x * x * x * y;
+static_assert(is_exactly<Rational<1, 21>, decltype(integrate(cube * cube, Var<1>{}, Zero{}, One{}, Var<2>{}, Zero{}, One{}))>());
+static_assert(is_exactly<Rational<1, 21>, decltype(integrate((cube * cube).primitive<1>(), Var<2>{}, Zero{}, One{})
+                                                   .evaluate_along_dim<1>(One{}))>());
+static_assert(is_exactly<Rational<-4, 3>, decltype(integrate((x + One{}) * (x - One{}) * (x + One{}), Var<1>{}, Intg<-1>{}, One{}))>());
+
+//Monomials of negative order.
+static_assert(is_exactly<Rational<1, 2>, decltype(integrate(Monomial<-2, 1>{}, Var<1>{}, One{}, Intg<2>{}))>());
+static_assert(is_exactly<Rational<3, 8>, decltype(integrate(Monomial<-3, 1>{}, Var<1>{}, One{}, Intg<2>{}))>());
+static_assert(is_exactly<Rational<3, 4>, decltype(integrate(Monomial<-2, 1>{} * y, Var<1>{}, One{}, Intg<2>{}, Var<2>{}, One{}, Intg<2>{}))>());
+
+int main()
+{
+  return 0;
+}
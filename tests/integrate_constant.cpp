@@ -0,0 +1,34 @@
+#include "simbpolic.h"
+#include "check.h"
+
+//Integrands with runtime (Constant) coefficients must give the same integrals
+//as their exact counterparts, whichever path integrate takes for them.
+
+using namespace Simbpolic;
+
+int main()
+{
+  const Monomial<1, 1> x;
+  const Monomial<1, 2> y;
+  const auto tent = branched(Var<1>{}, Zero{}, Intg<-1>{}, x + One{}, Zero{}, One{} - x, One{}, Zero{});
+
+  SIMBPOLIC_CHECK(Type(Zero{} - Constant{3.}) == -3.);
+
+  //The value of the integral before integrate started distributing the integrands.
+  SIMBPOLIC_CHECK_CLOSE(Type(integrate(tent * (x + Constant{2.}), Var<1>{}, Constant{-2.}, Constant{0.5})), 5. / 3.);
+  SIMBPOLIC_CHECK_CLOSE(Type(integrate(tent * (x + Constant{2.}), Var<1>{}, Intg<-2>{}, Rational<1, 2>{})), 5. / 3.);
+  SIMBPOLIC_CHECK_CLOSE(Type(integrate(tent * (x + Intg<2>{}), Var<1>{}, Constant{-2.}, Constant{0.5})), 5. / 3.);
+
+  const auto f = tent * (Constant{0.5} * x - Constant{1.5});
+  const auto f_exact = tent * (Rational<1, 2>{} * x - Rational<3, 2>{});
+  SIMBPOLIC_CHECK_CLOSE(Type(integrate(f, Var<1>{}, Constant{-3.}, Constant{3.})),
+                        Type(integrate(f_exact, Var<1>{}, Intg<-3>{}, Intg<3>{})));
+  SIMBPOLIC_CHECK_CLOSE(Type(integrate(f, Var<1>{}, Constant{-0.5}, Constant{0.25})),
+                        integrate_quadrature(f, Var<1>{}, -0.5, 0.25));
+
+  const auto g = x * x - y * Constant{2.};
+  SIMBPOLIC_CHECK_CLOSE(Type(g.derivative<2>()(1., 1.)), -2.);
+  SIMBPOLIC_CHECK_CLOSE(Type(integrate(g, Var<2>{}, Zero{}, One{})(3.)), 8.);
+
+  return check_failures;
+}
@@ -0,0 +1,32 @@
+#include "simbpolic.h"
+#include "check.h"
+
+//integrate distributes (see distribute_fully) the integrands that become simpler to integrate that way:
+//the distributed form must give the same integrals as the quadrature of the original one.
+
+using namespace Simbpolic;
+
+int main()
+{
+  const Monomial<1, 1> x;
+  const Monomial<1, 2> y;
+  const auto tent = branched(Var<1>{}, Zero{}, Intg<-1>{}, x + One{}, Zero{}, One{} - x, One{}, Zero{});
+
+  const auto f = tent * (x + Intg<2>{});
+  const auto g = (x + y) * (x - Intg<3>{} * y);
+  const double points[][2] = {{-1.5, 0.25}, {-0.5, 2.}, {0., -1.}, {0.75, 0.5}, {2., 3.}};
+  for (const auto& p : points)
+    {
+      SIMBPOLIC_CHECK_CLOSE(Type(distribute_fully(f)(p[0])), Type(f(p[0])));
+      SIMBPOLIC_CHECK_CLOSE(Type(distribute_fully(g)(p[0], p[1])), Type(g(p[0], p[1])));
+    }
+
+  SIMBPOLIC_CHECK_CLOSE(Type(integrate(f, Var<1>{}, Intg<-2>{}, Rational<1, 2>{})),
+                        integrate_quadrature(f, Var<1>{}, -2., 0.5));
+  SIMBPOLIC_CHECK_CLOSE(Type(integrate(f, Var<1>{}, Rational<-1, 2>{}, Intg<3>{})),
+                        integrate_quadrature(f, Var<1>{}, -0.5, 3.));
+  SIMBPOLIC_CHECK_CLOSE(Type(integrate(g, Var<1>{}, Intg<0>{}, Intg<1>{}, Var<2>{}, Intg<-1>{}, Intg<2>{})),
+                        integrate_quadrature(g, Var<1>{}, 0., 1., Var<2>{}, -1., 2.));
+
+  return check_failures;
+}
@@ -0,0 +1,43 @@
+#include "simbpolic.h"
+#include "check.h"
+
+//Evaluating over many sets of constants laid out as a structure of arrays
+//must give the same values as binding each set and evaluating the bound function.
+
+using namespace Simbpolic;
+
+int main()
+{
+  const Monomial<1, 1> x;
+  const Monomial<1, 2> y;
+  const auto f = branched(Var<1>{}, Stored<0>{} * x * x + y, Stored<2>{}, Stored<1>{} * y - x, Intg<3>{}, Stored<0>{} - Stored<1>{});
+
+  constexpr std::size_t num_sets = 5;
+  //parameters[i * num_sets + s] is the value of Stored<i> in the set s.
+  const Type parameters[3 * num_sets] = { 1.,  -2.,   0.5, 3.,   -0.25,
+                                          4.,   0.75, -1., 2.,    6.,
+                                          0.5,  1.5,   2., -1.,   1.25 };
+  const Type points[][2] = {{0.25, -1.}, {1., 2.}, {1.75, 0.5}, {2.5, -3.}, {4., 1.}, {0.5, 0.5}};
+
+  for (const auto& point : points)
+    {
+      Type results[num_sets] {};
+      evaluate_sweep(f, parameters, num_sets, results, point[0], point[1]);
+      for (std::size_t s = 0; s < num_sets; ++s)
+        {
+          const ParameterStore<3> store(parameters[s], parameters[num_sets + s], parameters[2 * num_sets + s]);
+          const auto bound = bind(f, store);
+          SIMBPOLIC_CHECK_CLOSE(results[s], Type(bound(point[0], point[1])));
+          SIMBPOLIC_CHECK_CLOSE(results[s], eval(bound, point[0], point[1]));
+        }
+    }
+
+  //The same set repeated gives the same value for every set.
+  const Type repeated[3 * 2] = {2., 2., -1., -1., 1., 1.};
+  Type results[2] {};
+  evaluate_sweep(f, repeated, 2, results, 0.5, 3.);
+  SIMBPOLIC_CHECK_CLOSE(results[0], 2. * 0.25 + 3.);
+  SIMBPOLIC_CHECK_CLOSE(results[1], results[0]);
+
+  return check_failures;
+}
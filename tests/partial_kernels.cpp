@@ -0,0 +1,55 @@
+#include "simbpolic.h"
+#include "check.h"
+
+//Fixing one coordinate of a kernel that is branched along the others (a tensor product of tents, say)
+//must give the same values as evaluating the kernel itself, including at the cut-off points.
+
+using namespace Simbpolic;
+
+int main()
+{
+  const Monomial<1, 1> x;
+  const Monomial<1, 2> y;
+  const Monomial<1, 3> z;
+  const auto tent_x = branched(Var<1>{}, Zero{}, Intg<-1>{}, x + One{}, Zero{}, One{} - x, One{}, Zero{});
+  const auto tent_y = branched(Var<2>{}, Zero{}, Intg<-1>{}, y + One{}, Zero{}, One{} - y, One{}, Zero{});
+  const auto tent_z = branched(Var<3>{}, Zero{}, Intg<-1>{}, z + One{}, Zero{}, One{} - z, One{}, Zero{});
+  const auto kernel = tent_x * tent_y * tent_z;
+  const auto weighted = kernel * (x + y * z + Constant{2.});
+
+  //The grid goes through all the cut-off points.
+  const Type values[] = {-1.5, -1., -0.75, -0.5, 0., 0.25, 0.5, 1., 1.25};
+
+  for (const Type fixed : {0.25, 0., -1., 2.})
+    {
+      const auto along_x = partial(kernel, Var<1>{}, fixed);
+      const auto weighted_x = partial(weighted, Var<1>{}, fixed);
+      const auto along_y = partial(weighted, Var<2>{}, fixed);
+      for (const Type a : values)
+        {
+          for (const Type b : values)
+            {
+              SIMBPOLIC_CHECK_CLOSE(along_x(a, b), eval(kernel, fixed, a, b));
+              SIMBPOLIC_CHECK_CLOSE(weighted_x(a, b), eval(weighted, fixed, a, b));
+              SIMBPOLIC_CHECK_CLOSE(along_y(a, b), eval(weighted, a, fixed, b));
+            }
+        }
+    }
+
+  //Jumps along the remaining dimensions give the average of both sides at the cut-off points.
+  const auto box_y = branched(Var<2>{}, Zero{}, Rational<-1, 2>{}, One{}, Rational<1, 2>{}, Zero{});
+  const auto step = box_y * tent_x * (z + Constant{3.});
+  const auto fixed_step = partial(step, Var<1>{}, 0.5);
+  for (const Type a : {-0.75, -0.5, 0., 0.5, 0.75})
+    {
+      SIMBPOLIC_CHECK_CLOSE(fixed_step(a, 1.), eval(step, 0.5, a, 1.));
+    }
+  SIMBPOLIC_CHECK_CLOSE(fixed_step(0.5, 1.), 0.5 * 0.5 * 4.);
+
+  //Without branches along the remaining dimensions, there is a single polynomial.
+  const auto polynomial = partial(tent_x * (y * y + z), Var<1>{}, 0.5);
+  static_assert(std::decay_t<decltype(polynomial)>::num_cells == 1);
+  SIMBPOLIC_CHECK_CLOSE(polynomial(2., 3.), 0.5 * 7.);
+
+  return check_failures;
+}
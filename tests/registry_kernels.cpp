@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <new>
+
+#include "registry_kernels.h"
+#include "check.h"
+
+//Registering a kernel (even one too large to be kept inside an any_function) must not allocate,
+//and using the macro in a header included by several translation units must register a single kernel.
+
+static int allocations = 0;
+
+void* operator new (std::size_t size)
+{
+  ++allocations;
+  void* ret = std::malloc(size == 0 ? 1 : size);
+  if (ret == nullptr)
+    {
+      throw std::bad_alloc{};
+    }
+  return ret;
+}
+
+void operator delete (void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete (void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+using namespace Simbpolic;
+
+int main()
+{
+  SIMBPOLIC_CHECK(allocations == 0);
+
+  const kernel_registry& registry = kernel_registry::global();
+  const any_function* kernel = registry.find("test_large_kernel");
+  SIMBPOLIC_CHECK(registry.size() == 1);
+  SIMBPOLIC_CHECK(kernel != nullptr);
+  SIMBPOLIC_CHECK(kernel == other_translation_unit_kernel());
+  SIMBPOLIC_CHECK(kernel == registry.find(kernel_id("test_large_kernel")));
+  SIMBPOLIC_CHECK(sizeof(simbpolic_kernel_model_test_large_kernel) > internals::any_function_buffer_size);
+
+  if (kernel != nullptr)
+    {
+      const Type xs[3] = {-1., 0.5, 2.}, ys[3] = {0.5, 1., -2.};
+      const Type* coordinates[2] = {xs, ys};
+      Type results[3];
+      kernel->evaluate(coordinates, 3, results);
+      for (int i = 0; i < 3; ++i)
+        {
+          const Type x = xs[i], y = ys[i];
+          const Type piece = (x < 0 ? x * 1.5 + 0.5 : x * x * 2. - 0.25);
+          SIMBPOLIC_CHECK_CLOSE(results[i], piece * (y + 3.) * 0.75);
+        }
+
+      const any_function copy = *kernel;
+      Type copied[3];
+      copy.evaluate(coordinates, 3, copied);
+      SIMBPOLIC_CHECK(copied[0] == results[0] && copied[2] == results[2]);
+    }
+
+  return check_failures;
+}
@@ -0,0 +1,16 @@
+#ifndef SIMBPOLIC_TESTS_REGISTRY_KERNELS
+#define SIMBPOLIC_TESTS_REGISTRY_KERNELS
+
+#include "simbpolic/registry.h"
+
+//Included by both translation units of the test: the kernel must still be registered only once.
+
+SIMBPOLIC_REGISTER_KERNEL(test_large_kernel,
+                          Simbpolic::branched(Simbpolic::Var<1>{}, Simbpolic::Monomial<1, 1>{} * Simbpolic::Constant{1.5} + Simbpolic::Constant{0.5},
+                                              Simbpolic::Zero{},
+                                              Simbpolic::Monomial<2, 1>{} * Simbpolic::Constant{2.} - Simbpolic::Constant{0.25}) *
+                          (Simbpolic::Monomial<1, 2>{} + Simbpolic::Constant{3.}) * Simbpolic::Constant{0.75})
+
+const Simbpolic::any_function* other_translation_unit_kernel();
+
+#endif
@@ -0,0 +1,6 @@
+#include "registry_kernels.h"
+
+const Simbpolic::any_function* other_translation_unit_kernel()
+{
+  return &simbpolic_kernel_test_large_kernel;
+}
@@ -0,0 +1,212 @@
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "simbpolic/serialize.h"
+#include "check.h"
+
+//Serialized expressions must evaluate (in place or after being read back) as the originals do,
+//and truncated or corrupted data must be rejected when the view is built.
+
+using namespace Simbpolic;
+
+struct aligned_bytes
+//A copy of the serialized data, aligned as the view requires.
+{
+  std::unique_ptr<std::max_align_t[]> storage;
+  std::size_t size;
+
+  explicit aligned_bytes(const std::vector<unsigned char>& data, const std::size_t keep):
+    storage(new std::max_align_t[keep / sizeof(std::max_align_t) + 1]), size(keep)
+  {
+    std::memcpy(storage.get(), data.data(), keep);
+  }
+
+  unsigned char* data()
+  {
+    return reinterpret_cast<unsigned char*>(storage.get());
+  }
+};
+
+bool rejects(const std::vector<unsigned char>& data, const std::size_t size)
+{
+  aligned_bytes copy(data, size);
+  try
+    {
+      serialized_view view(copy.data(), copy.size);
+    }
+  catch (const std::invalid_argument&)
+    {
+      return true;
+    }
+  return false;
+}
+
+serialized_node read_node(const std::vector<unsigned char>& data, const std::size_t i)
+{
+  serialized_header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  serialized_node ret;
+  std::memcpy(&ret, data.data() + internals::serialized_layout(header).nodes + i * sizeof(serialized_node), sizeof(ret));
+  return ret;
+}
+
+void write_node(std::vector<unsigned char>& data, const std::size_t i, const serialized_node& node)
+{
+  serialized_header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  std::memcpy(data.data() + internals::serialized_layout(header).nodes + i * sizeof(serialized_node), &node, sizeof(node));
+}
+
+void write_operand(std::vector<unsigned char>& data, const std::size_t j, const std::uint64_t value)
+{
+  serialized_header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  std::memcpy(data.data() + internals::serialized_layout(header).operands + j * sizeof(std::uint64_t), &value, sizeof(value));
+}
+
+int main()
+{
+  dynamic_arena arena;
+  const auto x = arena.variable(1);
+  const auto y = arena.variable(2);
+  const auto shared = arena.add(arena.multiply(arena.rational(3, 7), arena.multiply(x, x)), arena.multiply(arena.constant(0.1), y));
+  const auto pieces = arena.piecewise(1, {arena.rational(-1, 3), arena.stored(0), arena.constant(1.25)},
+                                      {arena.rational(0), arena.multiply(shared, y), arena.subtract(shared, arena.stored(1)), arena.constant(2.5)});
+  const auto f = arena.add(pieces, arena.divide(arena.multiply(shared, shared), arena.add(arena.monomial(2, 2), arena.rational(1))));
+
+  const std::vector<unsigned char> data = serialize(f);
+  aligned_bytes bytes(data, data.size());
+  const serialized_view view(bytes.data(), bytes.size);
+  SIMBPOLIC_CHECK(view.num_values() == 3);
+
+  dynamic_arena other;
+  const auto read = deserialize(view, other);
+  SIMBPOLIC_CHECK(deserialize(view, arena) == f);
+
+  const Type parameters[2] = {0.5, -2.};
+  const Type points[][2] = {{-1., 0.5}, {-1. / 3., 2.}, {0., -1.}, {0.5, 0.25}, {1., 3.}, {1.25, -0.5}, {3., 1.}};
+  for (const auto& point : points)
+    {
+      const Type expected = evaluate_dynamic(f, point, parameters);
+      SIMBPOLIC_CHECK(evaluate_serialized(view, point, parameters) == expected);
+      SIMBPOLIC_CHECK(evaluate_dynamic(read, point, parameters) == expected);
+    }
+
+  //Every truncation is rejected.
+  for (std::size_t size = 0; size < data.size(); ++size)
+    {
+      SIMBPOLIC_CHECK(rejects(data, size));
+    }
+  SIMBPOLIC_CHECK(!rejects(data, data.size()));
+
+  //Corrupted headers.
+  {
+    std::vector<unsigned char> bad = data;
+    bad[0] = 'X';
+    SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+  }
+  {
+    serialized_header header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    for (const auto change : {+[](serialized_header& h) { h.version = 2; },
+                              +[](serialized_header& h) { h.byte_order = 0x04030201; },
+                              +[](serialized_header& h) { h.type_size = 4; },
+                              +[](serialized_header& h) { h.root = h.num_nodes; },
+                              +[](serialized_header& h) { h.num_nodes = 0; },
+                              +[](serialized_header& h) { h.num_values = std::uint64_t(1) << 40; },
+                              +[](serialized_header& h) { h.num_operands = h.num_operands + 64; }})
+      {
+        serialized_header changed = header;
+        change(changed);
+        std::vector<unsigned char> bad = data;
+        std::memcpy(bad.data(), &changed, sizeof(changed));
+        SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+      }
+  }
+
+  //Corrupted nodes.
+  std::size_t piecewise = 0, monomial = 0, rational = 0, constant = 0, sum = 0;
+  for (std::size_t i = 0; i < view.num_nodes(); ++i)
+    {
+      switch (view.kind(i))
+        {
+          case dynamic_kind::piecewise:
+            piecewise = i;
+            break;
+          case dynamic_kind::monomial:
+            monomial = (monomial == 0 && i < view.root() ? i : monomial);
+            break;
+          case dynamic_kind::rational:
+            rational = i;
+            break;
+          case dynamic_kind::constant:
+            constant = i;
+            break;
+          case dynamic_kind::add:
+            sum = (sum == 0 && i < view.root() ? i : sum);
+            break;
+          default:
+            break;
+        }
+    }
+  SIMBPOLIC_CHECK(view.kind(monomial) == dynamic_kind::monomial && monomial < piecewise && sum < piecewise && sum > 0);
+  const serialized_node piece = view.node(piecewise);
+  const std::size_t first_cut = std::size_t(piece.first) + std::size_t(piece.num_cuts) + 1;
+  {
+    //A monomial or a sum as a cut-off point.
+    std::vector<unsigned char> bad = data;
+    write_operand(bad, first_cut, monomial);
+    SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+    write_operand(bad, first_cut, sum);
+    SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+  }
+  {
+    //Numeric cut-off points out of order (-1/3 and 5/4 swapped, with the stored one between them).
+    std::vector<unsigned char> bad = data;
+    write_operand(bad, first_cut, view.operand(piecewise, std::size_t(piece.num_cuts) + 3));
+    write_operand(bad, first_cut + 2, view.operand(piecewise, std::size_t(piece.num_cuts) + 1));
+    SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+  }
+  {
+    //An operand that is not an earlier node.
+    std::vector<unsigned char> bad = data;
+    write_operand(bad, std::size_t(view.node(view.root()).first), view.root());
+    SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+  }
+  for (const auto change : {+[](serialized_node& n) { n.kind = 42; },
+                            +[](serialized_node& n) { n.num_cuts = 0; },
+                            +[](serialized_node& n) { n.dim = 65; },
+                            +[](serialized_node& n) { n.first = std::uint64_t(-1); }})
+    {
+      std::vector<unsigned char> bad = data;
+      serialized_node node = read_node(bad, piecewise);
+      change(node);
+      write_node(bad, piecewise, node);
+      SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+    }
+  {
+    std::vector<unsigned char> bad = data;
+    serialized_node node = read_node(bad, rational);
+    node.den = 0;
+    write_node(bad, rational, node);
+    SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+  }
+  {
+    std::vector<unsigned char> bad = data;
+    serialized_node node = read_node(bad, constant);
+    node.first = view.num_values();
+    write_node(bad, constant, node);
+    SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+  }
+  {
+    std::vector<unsigned char> bad = data;
+    serialized_node node = read_node(bad, monomial);
+    node.dim = 0;
+    write_node(bad, monomial, node);
+    SIMBPOLIC_CHECK(rejects(bad, bad.size()));
+  }
+
+  return check_failures;
+}
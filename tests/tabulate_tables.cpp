@@ -0,0 +1,50 @@
+#include "simbpolic.h"
+#include "check.h"
+
+//Tables of functions with exact coefficients and limits must be computed entirely at compile-time,
+//with the same values as evaluating each point, even when the limits have large numerators and denominators.
+
+using namespace Simbpolic;
+
+template <std::size_t N, class Func>
+constexpr bool matches(const std::array<Type, N>& table, const Func& f, const Type start, const Type end, const Type tolerance)
+{
+  for (std::size_t i = 0; i < N; ++i)
+    {
+      const Type expected = eval(f, (start * Type(N - 1 - i) + end * Type(i)) / Type(N - 1));
+      const Type difference = table[i] - expected;
+      if (difference > tolerance || -difference > tolerance)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+constexpr Monomial<1, 1> x {};
+constexpr auto f = branched(Var<1>{}, x * x, Rational<1, 2>{}, One{} - x, Intg<2>{}, Rational<1, 3>{} * x * x * x);
+
+//The points are multiples of 1/4, so they and the values are exact (including the averages at 1/2 and 2).
+constexpr auto table = tabulate<13>(f, Var<1>{}, Rational<-1, 2>{}, Rational<5, 2>{});
+static_assert(table[0] == 0.25 && table[4] == 0.375 && table[10] == (-1. + 8. / 3.) / 2. && table[12] == eval(f, 2.5));
+static_assert(matches(table, f, -0.5, 2.5, 0.));
+
+//Products of these numerators and denominators with the number of steps do not fit in a long long.
+constexpr Rational<-2147483647, 2147483646> wide_start {};
+constexpr Rational<2147483645, 2147483643> wide_end {};
+constexpr auto wide = tabulate<17>(x * x - x, Var<1>{}, wide_start, wide_end);
+static_assert(matches(wide, x * x - x, Type(wide_start), Type(wide_end), 1e-15));
+
+int main()
+{
+  //Limits only known at run-time use the numeric interpolation.
+  const auto runtime = tabulate<13>(f, Var<1>{}, Constant{-0.5}, Constant{2.5});
+  for (std::size_t i = 0; i < runtime.size(); ++i)
+    {
+      SIMBPOLIC_CHECK(runtime[i] == table[i]);
+    }
+  const auto single = tabulate<1>(f, Var<1>{}, Rational<1, 3>{}, Intg<5>{});
+  SIMBPOLIC_CHECK_CLOSE(single[0], 1. / 9.);
+
+  return check_failures;
+}
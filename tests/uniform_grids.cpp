@@ -0,0 +1,44 @@
+#include <vector>
+
+#include "simbpolic.h"
+#include "check.h"
+
+//Forward differencing on uniform grids must give the same values as evaluating each point,
+//whichever way the grid crosses the cut-off points.
+
+using namespace Simbpolic;
+
+template <class Func>
+void check_uniform(const Func& f, const Type x0, const Type h, const std::size_t N)
+{
+  std::vector<Type> out(N);
+  evaluate_uniform(f, Var<1>{}, x0, h, N, out.data());
+  for (std::size_t i = 0; i < N; ++i)
+    {
+      SIMBPOLIC_CHECK_CLOSE(out[i], eval(f, x0 + Type(i) * h));
+    }
+}
+
+int main()
+{
+  const Monomial<1, 1> x;
+  //A cubic that jumps at 1/2 and at 3 (where the average of both sides is taken).
+  const auto f = branched(Var<1>{}, x * x * x - Intg<2>{} * x, Rational<1, 2>{}, Intg<2>{} - x * x, Intg<3>{}, Rational<1, 4>{} * x);
+
+  //Points exactly on the cut-off points (h = 1/8 hits 1/2 and 3 from 0).
+  check_uniform(f, 0., 0.125, 40);
+  //Negative steps, also going through both cut-off points.
+  check_uniform(f, 4., -0.125, 40);
+  check_uniform(f, 3.3, -0.1, 50);
+  //Fewer points than the degree, in a single piece and across a cut-off point.
+  check_uniform(f, -1., 0.25, 2);
+  check_uniform(f, 0.25, 0.25, 3);
+  check_uniform(f, 0.5, 0.5, 1);
+  check_uniform(f, 0., 0.1, 0);
+  //Pieces much longer than the period at which the differences are seeded again.
+  check_uniform(f, -3., 0.01, 700);
+  check_uniform(f, 10., -0.01, 1000);
+  check_uniform(x * x * x * x, -1., 1. / 256, 600);
+
+  return check_failures;
+}